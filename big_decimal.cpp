@@ -0,0 +1,517 @@
+#include "big_decimal.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace big_num_arithmetic {
+
+namespace {
+
+const uint64_t kTablePowers = 256;
+
+const std::vector<BigInteger>& TablePowers() {
+  static const std::vector<BigInteger> powers = [] {
+    std::vector<BigInteger> result(kTablePowers);
+    result[0] = BigInteger(1);
+    for (uint64_t i = 1; i < kTablePowers; ++i) {
+      result[i] = result[i - 1] * 10;
+    }
+    return result;
+  }();
+  return powers;
+}
+
+// 10^(256 * 2^index). A deque keeps the references to the powers valid
+// while other threads append new ones.
+const BigInteger& SquaredPower(size_t index) {
+  static std::mutex mutex;
+  static std::deque<BigInteger> powers;
+  std::lock_guard<std::mutex> lock(mutex);
+  while (powers.size() <= index) {
+    if (powers.empty()) {
+      powers.push_back(TablePowers().back() * 10);
+    } else {
+      powers.push_back(powers.back() * powers.back());
+    }
+  }
+  return powers[index];
+}
+
+// Number of decimal digits of |VALUE|, 1 for zero. The estimate by the
+// bit length is off by at most one.
+uint64_t DecimalDigits(const BigInteger& value) {
+  uint64_t bits = value.BitLength();
+  if (bits <= 1) {
+    return 1;
+  }
+  uint64_t digits = static_cast<uint64_t>(
+      static_cast<double>(bits - 1) * std::log10(2.0)) + 1;
+  BigInteger magnitude = value.abs();
+  while (digits > 1 && magnitude < BigDecimal::PowerOfTen(digits - 1)) {
+    --digits;
+  }
+  while (magnitude >= BigDecimal::PowerOfTen(digits)) {
+    ++digits;
+  }
+  return digits;
+}
+
+// VALUE / DIVISOR rounded to an integer, for DIVISOR > 0. STICKY tells
+// that the exact numerator is a little bigger in magnitude than VALUE.
+BigInteger DivideRounded(const BigInteger& value, const BigInteger& divisor,
+                         RoundingMode rounding, bool sticky) {
+  BigInteger quotient = value / divisor;
+  BigInteger remainder = value - quotient * divisor;
+  if (remainder.Sign() == 0 && !sticky) {
+    return quotient;
+  }
+  // Where the dropped part is relative to one half.
+  std::strong_ordering half = remainder.abs() * 2 <=> divisor;
+  if (half == std::strong_ordering::equal && sticky) {
+    half = std::strong_ordering::greater;
+  }
+  int sign = value.Sign();
+  bool away = false;
+  switch (rounding) {
+    case RoundingMode::kHalfEven:
+      away = half > 0 || (half == 0 && quotient.TestBit(0));
+      break;
+    case RoundingMode::kHalfUp:
+      away = half >= 0;
+      break;
+    case RoundingMode::kHalfDown:
+      away = half > 0;
+      break;
+    case RoundingMode::kDown:
+      away = false;
+      break;
+    case RoundingMode::kUp:
+      away = true;
+      break;
+    case RoundingMode::kFloor:
+      away = sign < 0;
+      break;
+    case RoundingMode::kCeiling:
+      away = sign > 0;
+      break;
+  }
+  if (away) {
+    quotient += sign;
+  }
+  return quotient;
+}
+
+// HIGH - LOW for HIGH >= LOW, which may not fit int64_t.
+uint64_t ExponentGap(int64_t high, int64_t low) {
+  return static_cast<uint64_t>(high) - static_cast<uint64_t>(low);
+}
+
+int64_t AddExponents(int64_t lhs, int64_t rhs) {
+  int64_t result = 0;
+  if (__builtin_add_overflow(lhs, rhs, &result)) {
+    throw std::overflow_error("BigDecimal exponent overflow");
+  }
+  return result;
+}
+
+int64_t SubtractExponents(int64_t lhs, int64_t rhs) {
+  int64_t result = 0;
+  if (__builtin_sub_overflow(lhs, rhs, &result)) {
+    throw std::overflow_error("BigDecimal exponent overflow");
+  }
+  return result;
+}
+
+// Drops the trailing zeros of an exact result VALUE * 10^EXPONENT, while
+// the exponent stays at most PREFERRED, so that 100 / 4 is 25 and not
+// 25.000... with all the digits of the precision.
+void StripZeros(BigInteger& value, int64_t& exponent, int64_t preferred) {
+  while (exponent < preferred && value.Sign() != 0 &&
+         value % uint32_t{10} == 0) {
+    value = value / 10;
+    ++exponent;
+  }
+}
+
+// LOW, the operand of a sum with the smaller exponent, moved closer to
+// HIGH, so that aligning them for a sum rounded to PRECISION digits takes
+// about PRECISION digits however far apart they are:
+//  - a nonzero LOW wholly two digits below the last digit that HIGH keeps
+//    only decides the rounding, so one digit of its sign there stands for
+//    it (the sticky digit);
+//  - a zero LOW only sets the exponent of the sum, which is rounded to
+//    PRECISION digits of HIGH anyway.
+BigDecimal Approach(const BigDecimal& low, const BigDecimal& high,
+                    uint64_t precision) {
+  if (precision == 0 || high.Sign() == 0) {
+    return low;
+  }
+  __int128 high_exponent = high.Exponent();
+  if (low.Sign() == 0) {
+    __int128 lowest = high_exponent - precision;
+    return (low.Exponent() < lowest)
+        ? BigDecimal(BigInteger(), static_cast<int64_t>(lowest))
+        : low;
+  }
+  __int128 sticky_exponent = high_exponent + std::min<__int128>(
+      -1, static_cast<__int128>(high.Digits()) - precision - 2);
+  __int128 low_leading =
+      static_cast<__int128>(low.Exponent()) + low.Digits() - 1;
+  if (low_leading < sticky_exponent) {
+    return BigDecimal(BigInteger(low.Sign()),
+                      static_cast<int64_t>(sticky_exponent));
+  }
+  return low;
+}
+
+}  // namespace
+
+BigDecimal::BigDecimal() = default;
+
+BigDecimal::BigDecimal(BigInteger mantissa, int64_t exponent)
+    : mantissa_(std::move(mantissa)), exponent_(exponent) {}
+
+BigDecimal::BigDecimal(int64_t value) : mantissa_(value) {}
+
+BigInteger BigDecimal::PowerOfTen(uint64_t n) {
+  const std::vector<BigInteger>& table = TablePowers();
+  if (n < kTablePowers) {
+    return table[n];
+  }
+  BigInteger result = table[n % kTablePowers];
+  uint64_t high = n / kTablePowers;
+  for (size_t index = 0; high != 0; ++index, high >>= 1) {
+    if (high & 1) {
+      result *= SquaredPower(index);
+    }
+  }
+  return result;
+}
+
+// STRING PROCESSING
+
+BigDecimal BigDecimal::FromString(const std::string& str) {
+  size_t position = 0;
+  bool negative = false;
+  if (position < str.size() && (str[position] == '-' ||
+                                str[position] == '+')) {
+    negative = str[position] == '-';
+    ++position;
+  }
+  std::string digits;
+  int64_t fraction_digits = 0;
+  bool has_point = false;
+  for (; position < str.size(); ++position) {
+    char symbol = str[position];
+    if (symbol >= '0' && symbol <= '9') {
+      digits += symbol;
+      fraction_digits += has_point ? 1 : 0;
+    } else if (symbol == '.' && !has_point) {
+      has_point = true;
+    } else {
+      break;
+    }
+  }
+  if (digits.empty()) {
+    throw std::invalid_argument("Not a decimal number: " + str);
+  }
+  int64_t exponent = 0;
+  if (position < str.size()) {
+    if (str[position] != 'e' && str[position] != 'E') {
+      throw std::invalid_argument("Not a decimal number: " + str);
+    }
+    ++position;
+    bool negative_exponent = false;
+    if (position < str.size() && (str[position] == '-' ||
+                                  str[position] == '+')) {
+      negative_exponent = str[position] == '-';
+      ++position;
+    }
+    if (position == str.size()) {
+      throw std::invalid_argument("Not a decimal number: " + str);
+    }
+    for (; position < str.size(); ++position) {
+      if (str[position] < '0' || str[position] > '9' ||
+          exponent > (INT64_MAX - 9) / 10) {
+        throw std::invalid_argument("Not a decimal number: " + str);
+      }
+      exponent = exponent * 10 + (str[position] - '0');
+    }
+    if (negative_exponent) {
+      exponent = -exponent;
+    }
+  }
+  if (__builtin_sub_overflow(exponent, fraction_digits, &exponent)) {
+    throw std::invalid_argument("Not a decimal number: " + str);
+  }
+  BigInteger mantissa = BigInteger::FromString(digits, 10);
+  if (negative) {
+    mantissa.Negate();
+  }
+  return BigDecimal(std::move(mantissa), exponent);
+}
+
+std::string BigDecimal::ToString() const {
+  std::string digits = mantissa_.abs().ToString(10);
+  std::string sign = (mantissa_.Sign() < 0) ? "-" : "";
+  if (exponent_ >= 0) {
+    if (mantissa_.Sign() == 0) {
+      return "0";
+    }
+    return sign + digits + std::string(exponent_, '0');
+  }
+  uint64_t scale = static_cast<uint64_t>(-(exponent_ + 1)) + 1;
+  if (digits.size() <= scale) {
+    digits = std::string(scale - digits.size() + 1, '0') + digits;
+  }
+  digits.insert(digits.size() - scale, ".");
+  return sign + digits;
+}
+
+std::ostream& operator<<(std::ostream& output, const BigDecimal& value) {
+  return output << value.ToString();
+}
+
+// ADDITIONAL FUNCTIONS
+
+const BigInteger& BigDecimal::Mantissa() const {
+  return mantissa_;
+}
+
+int64_t BigDecimal::Exponent() const {
+  return exponent_;
+}
+
+int BigDecimal::Sign() const {
+  return mantissa_.Sign();
+}
+
+uint64_t BigDecimal::Digits() const {
+  return DecimalDigits(mantissa_);
+}
+
+// COMPARING
+
+bool BigDecimal::operator==(const BigDecimal& rhs) const {
+  return (*this <=> rhs) == std::strong_ordering::equal;
+}
+
+std::strong_ordering BigDecimal::operator<=>(const BigDecimal& rhs) const {
+  int sign = mantissa_.Sign();
+  if (sign != rhs.mantissa_.Sign()) {
+    return sign <=> rhs.mantissa_.Sign();
+  }
+  if (sign == 0) {
+    return std::strong_ordering::equal;
+  }
+  // The exponents of the leading digits decide, unless they are equal;
+  // they may not fit int64_t.
+  __int128 lhs_leading = static_cast<__int128>(exponent_) + Digits();
+  __int128 rhs_leading = static_cast<__int128>(rhs.exponent_) + rhs.Digits();
+  if (lhs_leading != rhs_leading) {
+    return (sign > 0) ? lhs_leading <=> rhs_leading
+                      : rhs_leading <=> lhs_leading;
+  }
+  if (exponent_ > rhs.exponent_) {
+    return mantissa_ * PowerOfTen(ExponentGap(exponent_, rhs.exponent_)) <=>
+        rhs.mantissa_;
+  }
+  return mantissa_ <=>
+      rhs.mantissa_ * PowerOfTen(ExponentGap(rhs.exponent_, exponent_));
+}
+
+// ROUNDING
+
+BigDecimal BigDecimal::RoundDigits(BigInteger value, int64_t exponent,
+                                   uint64_t precision, RoundingMode rounding,
+                                   bool sticky) {
+  uint64_t digits = DecimalDigits(value);
+  if (precision == 0 || (digits <= precision && !sticky)) {
+    return BigDecimal(std::move(value), exponent);
+  }
+  if (digits <= precision) {
+    // Only the sticky part is dropped: one more digit carries it.
+    value *= 10;
+    exponent = SubtractExponents(exponent, 1);
+    ++digits;
+  }
+  uint64_t dropped = digits - precision;
+  value = DivideRounded(value, PowerOfTen(dropped), rounding, sticky);
+  exponent = AddExponents(exponent, static_cast<int64_t>(dropped));
+  if (value.abs() == PowerOfTen(precision)) {
+    // Rounded up to one more digit, like 9.99 to 10.0.
+    value = value / 10;
+    exponent = AddExponents(exponent, 1);
+  }
+  return BigDecimal(std::move(value), exponent);
+}
+
+BigDecimal BigDecimal::Round(const DecimalContext& context) const {
+  return RoundDigits(mantissa_, exponent_, context.precision,
+                     context.rounding, false);
+}
+
+BigDecimal BigDecimal::Quantize(int64_t exponent,
+                                RoundingMode rounding) const {
+  if (mantissa_.Sign() == 0) {
+    return BigDecimal(BigInteger(), exponent);
+  }
+  if (exponent <= exponent_) {
+    return BigDecimal(mantissa_ * PowerOfTen(ExponentGap(exponent_, exponent)),
+                      exponent);
+  }
+  // All the digits are dropped once the gap is longer than the mantissa,
+  // and one more dropped zero doesn't change the rounding.
+  uint64_t dropped = std::min(ExponentGap(exponent, exponent_), Digits() + 1);
+  return BigDecimal(DivideRounded(mantissa_, PowerOfTen(dropped), rounding,
+                                  false),
+                    exponent);
+}
+
+BigInteger BigDecimal::ToBigInteger(RoundingMode rounding) const {
+  return Quantize(0, rounding).mantissa_;
+}
+
+// OPERATIONS
+
+BigDecimal BigDecimal::operator-() const {
+  return BigDecimal(-mantissa_, exponent_);
+}
+
+BigDecimal BigDecimal::operator+(const BigDecimal& rhs) const {
+  if (exponent_ == rhs.exponent_) {
+    return BigDecimal(mantissa_ + rhs.mantissa_, exponent_);
+  }
+  // A zero is not aligned, the sum takes the smaller exponent.
+  if (mantissa_.Sign() == 0 || rhs.mantissa_.Sign() == 0) {
+    const BigDecimal& other = (mantissa_.Sign() == 0) ? rhs : *this;
+    return other.Quantize(std::min(exponent_, rhs.exponent_));
+  }
+  if (exponent_ > rhs.exponent_) {
+    return BigDecimal(mantissa_ * PowerOfTen(ExponentGap(exponent_,
+                                                         rhs.exponent_)) +
+                      rhs.mantissa_, rhs.exponent_);
+  }
+  return BigDecimal(mantissa_ + rhs.mantissa_ *
+                    PowerOfTen(ExponentGap(rhs.exponent_, exponent_)),
+                    exponent_);
+}
+
+BigDecimal BigDecimal::operator-(const BigDecimal& rhs) const {
+  return *this + (-rhs);
+}
+
+BigDecimal BigDecimal::operator*(const BigDecimal& rhs) const {
+  return BigDecimal(mantissa_ * rhs.mantissa_,
+                    AddExponents(exponent_, rhs.exponent_));
+}
+
+BigDecimal BigDecimal::operator/(const BigDecimal& rhs) const {
+  return Divide(rhs);
+}
+
+void BigDecimal::operator+=(const BigDecimal& rhs) {
+  *this = *this + rhs;
+}
+
+void BigDecimal::operator-=(const BigDecimal& rhs) {
+  *this = *this - rhs;
+}
+
+void BigDecimal::operator*=(const BigDecimal& rhs) {
+  *this = *this * rhs;
+}
+
+void BigDecimal::operator/=(const BigDecimal& rhs) {
+  *this = Divide(rhs);
+}
+
+BigDecimal BigDecimal::Add(const BigDecimal& rhs,
+                           const DecimalContext& context) const {
+  if (exponent_ >= rhs.exponent_) {
+    return (*this + Approach(rhs, *this, context.precision)).Round(context);
+  }
+  return (Approach(*this, rhs, context.precision) + rhs).Round(context);
+}
+
+BigDecimal BigDecimal::Subtract(const BigDecimal& rhs,
+                                const DecimalContext& context) const {
+  return Add(-rhs, context);
+}
+
+BigDecimal BigDecimal::Multiply(const BigDecimal& rhs,
+                                const DecimalContext& context) const {
+  return (*this * rhs).Round(context);
+}
+
+BigDecimal BigDecimal::Divide(const BigDecimal& rhs,
+                              const DecimalContext& context) const {
+  if (rhs.mantissa_.Sign() == 0) {
+    throw DivisionByZeroError{};
+  }
+  if (context.precision == 0) {
+    throw std::invalid_argument("Division needs a positive precision");
+  }
+  int64_t ideal = SubtractExponents(exponent_, rhs.exponent_);
+  if (mantissa_.Sign() == 0) {
+    return BigDecimal(BigInteger(), ideal);
+  }
+  // Scale the numerator or the divisor so that the quotient has at least
+  // precision + 1 digits; the rest of the division is the sticky part.
+  int64_t shift = static_cast<int64_t>(context.precision) + 1 +
+      static_cast<int64_t>(rhs.Digits()) - static_cast<int64_t>(Digits());
+  BigInteger numerator = mantissa_;
+  BigInteger divisor = rhs.mantissa_;
+  if (shift > 0) {
+    numerator *= PowerOfTen(shift);
+  } else {
+    divisor *= PowerOfTen(-shift);
+  }
+  BigInteger quotient = numerator / divisor;
+  bool sticky = quotient * divisor != numerator;
+  int64_t exponent = SubtractExponents(ideal, shift);
+  if (!sticky) {
+    StripZeros(quotient, exponent, ideal);
+  }
+  return RoundDigits(std::move(quotient), exponent, context.precision,
+                     context.rounding, sticky);
+}
+
+BigDecimal BigDecimal::Sqrt(const DecimalContext& context) const {
+  if (mantissa_.Sign() < 0) {
+    throw std::runtime_error("Square root of negative number");
+  }
+  if (context.precision == 0) {
+    throw std::invalid_argument("Square root needs a positive precision");
+  }
+  if (mantissa_.Sign() == 0) {
+    // Half of the exponent, rounded down, as for the other exact roots.
+    return BigDecimal(BigInteger(), (exponent_ - (exponent_ & 1)) / 2);
+  }
+  // An even exponent and at least 2 precision + 2 digits of the mantissa,
+  // so that the root has precision + 1 digits before the rounding.
+  int64_t digits = static_cast<int64_t>(Digits());
+  int64_t shift = std::max<int64_t>(
+      0, 2 * static_cast<int64_t>(context.precision) + 2 - digits);
+  int64_t scaled_exponent = SubtractExponents(exponent_, shift);
+  if (scaled_exponent % 2 != 0) {
+    ++shift;
+    scaled_exponent = SubtractExponents(scaled_exponent, 1);
+  }
+  BigInteger value = mantissa_ * PowerOfTen(shift);
+  BigInteger root = BigInteger::IRoot(value, 2);
+  bool sticky = root * root != value;
+  int64_t exponent = scaled_exponent / 2;
+  if (!sticky) {
+    // Half of the exponent, rounded down.
+    StripZeros(root, exponent, (exponent_ - (exponent_ & 1)) / 2);
+  }
+  return RoundDigits(std::move(root), exponent, context.precision,
+                     context.rounding, sticky);
+}
+
+}  // namespace big_num_arithmetic
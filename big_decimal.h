@@ -0,0 +1,124 @@
+#ifndef BIG_DECIMAL_H_
+#define BIG_DECIMAL_H_
+
+#include "big_integer.h"
+#include <compare>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace big_num_arithmetic {
+
+enum class RoundingMode {
+  // To the nearest, ties to the even digit (banker's rounding).
+  kHalfEven,
+  // To the nearest, ties away from zero.
+  kHalfUp,
+  // To the nearest, ties towards zero.
+  kHalfDown,
+  // Towards zero.
+  kDown,
+  // Away from zero.
+  kUp,
+  // Towards minus infinity.
+  kFloor,
+  // Towards plus infinity.
+  kCeiling,
+};
+
+struct DecimalContext {
+  // Significant digits of the rounded results; 0 keeps all of them, which
+  // division and square root can't do.
+  uint64_t precision{34};
+  RoundingMode rounding{RoundingMode::kHalfEven};
+};
+
+// Decimal number mantissa * 10^exponent. Addition, subtraction and
+// multiplication by the operators are exact; the methods that take a
+// DecimalContext round their result to its precision, and Quantize()
+// rounds to a fixed number of decimal places, as money needs. The scale
+// is kept: 1.50 and 1.5 are equal numbers with different strings. The
+// operations throw std::overflow_error for a result whose exponent does
+// not fit int64_t.
+//
+// The powers of ten used for the rescaling come from a table that is
+// built once and shared by all threads.
+class BigDecimal {
+ public:
+  BigDecimal();
+  BigDecimal(BigInteger mantissa, int64_t exponent = 0);
+  explicit BigDecimal(int64_t);
+
+  // Plain or scientific notation: "-12.50", "1.5e-7", "2E+10". Throws
+  // std::invalid_argument for other strings.
+  static BigDecimal FromString(const std::string&);
+  // Plain notation with all the digits of the scale.
+  std::string ToString() const;
+  friend std::ostream& operator<<(std::ostream&, const BigDecimal&);
+
+  const BigInteger& Mantissa() const;
+  int64_t Exponent() const;
+  int Sign() const;
+  // Number of decimal digits of the mantissa, 1 for zero.
+  uint64_t Digits() const;
+
+  // COMPARING
+  // By value, whatever the scales are.
+  bool operator==(const BigDecimal&) const;
+  std::strong_ordering operator<=>(const BigDecimal&) const;
+
+  // ROUNDING
+  BigDecimal Round(const DecimalContext&) const;
+  // The number with the given exponent, rounded in the given mode; for
+  // example Quantize(-2) rounds to cents.
+  BigDecimal Quantize(int64_t exponent,
+                      RoundingMode = RoundingMode::kHalfEven) const;
+  BigInteger ToBigInteger(RoundingMode = RoundingMode::kDown) const;
+
+  // OPERATIONS
+  BigDecimal operator-() const;
+  BigDecimal operator+(const BigDecimal&) const;
+  BigDecimal operator-(const BigDecimal&) const;
+  BigDecimal operator*(const BigDecimal&) const;
+  // Divide() with the default context.
+  BigDecimal operator/(const BigDecimal&) const;
+  void operator+=(const BigDecimal&);
+  void operator-=(const BigDecimal&);
+  void operator*=(const BigDecimal&);
+  void operator/=(const BigDecimal&);
+
+  // Correctly rounded; an operand far below the precision of the other is
+  // not aligned digit by digit, it only decides the rounding.
+  BigDecimal Add(const BigDecimal&, const DecimalContext&) const;
+  BigDecimal Subtract(const BigDecimal&, const DecimalContext&) const;
+  BigDecimal Multiply(const BigDecimal&, const DecimalContext&) const;
+  // Correctly rounded quotient; exact quotients keep only the trailing
+  // zeros down to the difference of the exponents. Throws
+  // DivisionByZeroError for a zero divisor and std::invalid_argument for
+  // a zero precision.
+  BigDecimal Divide(const BigDecimal&,
+                    const DecimalContext& = DecimalContext()) const;
+  // Correctly rounded square root; exact roots keep the trailing zeros
+  // down to half of the exponent. Throws std::runtime_error for negative
+  // numbers and std::invalid_argument for a zero precision.
+  BigDecimal Sqrt(const DecimalContext& = DecimalContext()) const;
+
+  // 10^n. Powers below 10^256 are kept in a table, bigger ones are products
+  // of a table entry and cached powers 10^(256 * 2^k).
+  static BigInteger PowerOfTen(uint64_t);
+
+ private:
+  // VALUE * 10^EXPONENT rounded to PRECISION digits. STICKY tells that
+  // VALUE was truncated: the exact mantissa is a little bigger in
+  // magnitude.
+  static BigDecimal RoundDigits(BigInteger value, int64_t exponent,
+                                uint64_t precision, RoundingMode,
+                                bool sticky);
+
+  BigInteger mantissa_;
+  int64_t exponent_{0};
+};
+
+}  // namespace big_num_arithmetic
+
+#endif  // BIG_DECIMAL_H_
@@ -0,0 +1,129 @@
+#include "big_decimal.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <stdexcept>
+
+namespace big_num_arithmetic {
+
+TEST(Test_48, BigDecimals) {
+  EXPECT_EQ(BigDecimal::FromString("-12.50").ToString(), "-12.50");
+  EXPECT_EQ(BigDecimal::FromString("1.5e-7").ToString(), "0.00000015");
+  EXPECT_EQ(BigDecimal::FromString("2E+3").ToString(), "2000");
+  EXPECT_EQ(BigDecimal::FromString(".5").ToString(), "0.5");
+  EXPECT_EQ(BigDecimal::FromString("-0.000").ToString(), "0.000");
+  EXPECT_EQ(BigDecimal::FromString("+7.").ToString(), "7");
+  for (const char* wrong : {"", "-", ".", "1.2.3", "1e", "1e+", "12a",
+                            "1e99999999999999999999",
+                            "0.0000000000001e-9223372036854775799"}) {
+    EXPECT_THROW(BigDecimal::FromString(wrong), std::invalid_argument);
+  }
+  std::ostringstream output;
+  output << BigDecimal(BigInteger(-5), -3);
+  EXPECT_EQ(output.str(), "-0.005");
+
+  BigDecimal price = BigDecimal::FromString("19.99");
+  BigDecimal rate = BigDecimal::FromString("0.0725");
+  EXPECT_EQ((price * rate).ToString(), "1.449275");
+  EXPECT_EQ((price * rate).Quantize(-2).ToString(), "1.45");
+  EXPECT_EQ((price + rate).ToString(), "20.0625");
+  EXPECT_EQ((rate - price).ToString(), "-19.9175");
+  EXPECT_TRUE(BigDecimal::FromString("1.50") == BigDecimal::FromString("1.5"));
+  EXPECT_TRUE(BigDecimal::FromString("-1e5") < BigDecimal::FromString("-9"));
+  EXPECT_TRUE(BigDecimal::FromString("0.1") > BigDecimal::FromString("0.09"));
+  EXPECT_TRUE(BigDecimal() == BigDecimal::FromString("0.00"));
+  EXPECT_EQ(BigDecimal::FromString("12345.678").Digits(), 8u);
+  EXPECT_EQ(BigDecimal::FromString("-2.5").ToBigInteger(), -2);
+
+  // Exponents at the ends of int64_t.
+  BigDecimal largest(BigInteger(1), INT64_MAX);
+  BigDecimal smallest(BigInteger(1), INT64_MIN);
+  EXPECT_THROW(largest * BigDecimal(BigInteger(1), 1), std::overflow_error);
+  EXPECT_THROW(smallest * BigDecimal(BigInteger(1), -1), std::overflow_error);
+  EXPECT_THROW(BigDecimal(1).Divide(smallest), std::overflow_error);
+  EXPECT_TRUE(smallest < largest && -largest < -smallest);
+  EXPECT_TRUE(BigDecimal(BigInteger(10), INT64_MAX - 1) == largest);
+  EXPECT_EQ(smallest.Quantize(INT64_MAX).ToString(), "0");
+  EXPECT_EQ(smallest.Quantize(INT64_MAX, RoundingMode::kUp).Mantissa(), 1);
+  EXPECT_EQ(BigDecimal(BigInteger(), INT64_MIN).Quantize(0).ToString(), "0");
+
+  // The rounding modes on the ties and near them.
+  struct Case {
+    const char* value;
+    RoundingMode rounding;
+    const char* result;
+  };
+  for (const Case& test : std::initializer_list<Case>{
+           {"2.5", RoundingMode::kHalfEven, "2"},
+           {"3.5", RoundingMode::kHalfEven, "4"},
+           {"-2.5", RoundingMode::kHalfEven, "-2"},
+           {"2.5", RoundingMode::kHalfUp, "3"},
+           {"-2.5", RoundingMode::kHalfUp, "-3"},
+           {"2.5", RoundingMode::kHalfDown, "2"},
+           {"2.51", RoundingMode::kHalfDown, "3"},
+           {"-2.9", RoundingMode::kDown, "-2"},
+           {"2.1", RoundingMode::kUp, "3"},
+           {"-2.1", RoundingMode::kFloor, "-3"},
+           {"-2.1", RoundingMode::kCeiling, "-2"},
+           {"2.1", RoundingMode::kCeiling, "3"},
+           {"9.5", RoundingMode::kHalfEven, "10"}}) {
+    EXPECT_EQ(BigDecimal::FromString(test.value).Quantize(0, test.rounding)
+                  .ToString(), test.result) << test.value;
+  }
+  EXPECT_EQ(BigDecimal::FromString("999.96").Round({4, RoundingMode::kHalfUp})
+                .ToString(), "1000");
+  EXPECT_EQ(BigDecimal::FromString("123456").Round({2}).ToString(),
+            "120000");
+
+  // Division and square root are correctly rounded.
+  BigDecimal one(1);
+  BigDecimal three(3);
+  EXPECT_EQ((one / three).ToString(),
+            "0.3333333333333333333333333333333333");
+  EXPECT_EQ(one.Divide(three, {5, RoundingMode::kUp}).ToString(), "0.33334");
+  EXPECT_EQ(BigDecimal(2).Divide(three, {3}).ToString(), "0.667");
+  EXPECT_EQ(BigDecimal(-2).Divide(three, {3, RoundingMode::kFloor})
+                .ToString(), "-0.667");
+  EXPECT_EQ(BigDecimal(1).Divide(BigDecimal(8), {1}).ToString(), "0.1");
+  EXPECT_EQ(BigDecimal(100).Divide(BigDecimal(4)).ToString(), "25");
+  EXPECT_EQ(BigDecimal(2).Sqrt({20}).ToString(), "1.4142135623730950488");
+  EXPECT_EQ(BigDecimal::FromString("0.0144").Sqrt({5}).ToString(), "0.12");
+  EXPECT_EQ(BigDecimal::FromString("1e-5").Sqrt({3}).ToString(), "0.00316");
+  EXPECT_EQ(BigDecimal::FromString("4.0").Sqrt().ToString(), "2.0");
+  EXPECT_EQ(BigDecimal::FromString("0E30").Sqrt({30}).ToString(), "0");
+  EXPECT_EQ(BigDecimal::FromString("0E30").Sqrt({30}).Exponent(), 15);
+  EXPECT_EQ(BigDecimal::FromString("0.000").Sqrt().Exponent(), -2);
+  EXPECT_EQ(BigDecimal::FromString("0.00").Sqrt().ToString(), "0.0");
+  EXPECT_EQ(BigDecimal::FromString("1.00").Divide(BigDecimal(5)).ToString(),
+            "0.20");
+  EXPECT_THROW(one / BigDecimal(), DivisionByZeroError);
+  EXPECT_THROW(one.Divide(three, {0}), std::invalid_argument);
+  EXPECT_THROW(BigDecimal(-1).Sqrt(), std::runtime_error);
+
+  // The cached powers.
+  EXPECT_TRUE(BigDecimal::PowerOfTen(0) == 1);
+  EXPECT_EQ(BigDecimal::PowerOfTen(1000).ToString(10),
+            "1" + std::string(1000, '0'));
+  EXPECT_TRUE(BigDecimal::PowerOfTen(300) ==
+              BigDecimal::PowerOfTen(256) * BigDecimal::PowerOfTen(44));
+  BigDecimal tiny(BigInteger(1), -600);
+  EXPECT_EQ(tiny.Digits(), 1u);
+  EXPECT_TRUE(tiny * BigDecimal(BigInteger(1), 600) == one);
+  EXPECT_EQ((tiny + one).Round({3}).ToString(), "1.00");
+  EXPECT_EQ(tiny.Add(one, {3, RoundingMode::kUp}).ToString(), "1.01");
+  EXPECT_EQ(one.Subtract(tiny, {3, RoundingMode::kDown}).ToString(),
+            "0.999");
+
+  // Far apart operands of rounded sums are not aligned digit by digit.
+  BigDecimal far(BigInteger(1), 1000000000);
+  BigDecimal sum = far.Add(one, {34});
+  EXPECT_TRUE(sum.Mantissa() == BigDecimal::PowerOfTen(33));
+  EXPECT_EQ(sum.Exponent(), 1000000000 - 33);
+  BigDecimal difference = far.Subtract(one, {34, RoundingMode::kDown});
+  EXPECT_TRUE(difference.Mantissa() == BigDecimal::PowerOfTen(34) - 1);
+  EXPECT_EQ(difference.Exponent(), 1000000000 - 34);
+  sum = far.Add(BigDecimal(BigInteger(), -1000000000), {34});
+  EXPECT_EQ(sum.Exponent(), 1000000000 - 33);
+  EXPECT_TRUE(sum == far);
+}
+
+}  // namespace big_num_arithmetic
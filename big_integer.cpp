@@ -1,77 +1,148 @@
 #include "big_integer.h"
+#include "executor.h"
+#include "mod_context.h"
 #include <stdexcept>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cmath>
 #include <iostream>
 #include <limits>
 
 namespace big_num_arithmetic {
 
-int BigInteger::internal_base = 150;
-
-BigInteger::BigInteger(int64_t short_number) {
-  digits_.clear();
-  if (short_number == INT64_MIN) {
-    sign_ = -1;
-    int64_t new_value = INT64_MAX;
-    while (new_value) {
-      digits_.push_back(new_value % internal_base);
-      new_value /= internal_base;
-    }
-    digits_.at(0)++;
-  } else if (short_number == 0) {
-    sign_ = 0;
-    digits_.push_back(0);
-  } else {
-    sign_ = (short_number < 0) ? -1 : 1;
-    int64_t new_value = (short_number < 0) ? -short_number : short_number;
-    while (new_value) {
-      digits_.push_back(new_value % internal_base);
-      new_value /= internal_base;
-    }
+BigInteger::operator int64_t() const {
+  std::optional<int64_t> short_number = TryToInt64();
+  if (!short_number || *short_number == INT64_MIN) {
+    throw std::runtime_error("int64_t overflow");
   }
+  return *short_number;
 }
 
-BigInteger::operator int64_t() const {
-  std::string big_str = ((*this).abs()).ToString(10);
-  std::string allowed_int64_str = "9223372036854775807";
-  if (big_str.size() > allowed_int64_str.size() ||
-     (big_str.size() == allowed_int64_str.size() &&
-                                              big_str > allowed_int64_str)) {
-    throw std::runtime_error("int64_t overflow");
+// NATIVE CONVERSIONS
+
+namespace {
+
+// |VALUE|, if it has at most four digits.
+std::optional<unsigned __int128> Magnitude(const BigInteger& value) {
+  const std::vector<uint32_t>& digits = value.Limbs();
+  if (digits.size() > 4) {
+    return std::nullopt;
   }
-  int64_t short_number = std::stoll(big_str);
-  if (sign_ > 0) {
-    return short_number;
-  } else {
-    return -short_number;
+  unsigned __int128 magnitude = 0;
+  for (size_t i = digits.size(); i-- > 0;) {
+    magnitude = (magnitude << 32) | digits[i];
   }
+  return magnitude;
 }
 
-// ADDITIONAL FUNCTIONS
+// Converts VALUE to a signed type whose maximum is MAX, with the minimum
+// of -MAX - 1.
+template<typename Integer>
+std::optional<Integer> ToSigned(const BigInteger& value,
+                                unsigned __int128 max) {
+  std::optional<unsigned __int128> magnitude = Magnitude(value);
+  if (!magnitude || *magnitude > max + ((value.Sign() < 0) ? 1 : 0)) {
+    return std::nullopt;
+  }
+  // Negating in unsigned arithmetic keeps the minimum representable.
+  if (value.Sign() < 0) {
+    *magnitude = 0 - *magnitude;
+  }
+  return static_cast<Integer>(*magnitude);
+}
+
+}  // namespace
 
-int BigInteger::Sign() const {
-  return sign_;
+BigInteger::BigInteger(double short_number) {
+  if (!std::isfinite(short_number)) {
+    throw std::runtime_error("Non-finite double");
+  }
+  // short_number = fraction * 2^exponent, 0.5 <= |fraction| < 1, so the
+  // fraction scaled by 2^53 is an exact integer.
+  int exponent = 0;
+  double fraction = std::frexp(std::fabs(short_number), &exponent);
+  BigInteger magnitude(static_cast<uint64_t>(std::ldexp(fraction, 53)));
+  exponent -= 53;
+  (*this) = (exponent >= 0) ? magnitude << exponent
+                            : magnitude >> -exponent;
+  if (short_number < 0) {
+    Negate();
+  }
 }
 
-void BigInteger::Negate() {
-  sign_ = -sign_;
+bool BigInteger::FitsInt64() const {
+  return TryToInt64().has_value();
 }
 
-BigInteger BigInteger::negate() {
-  sign_ = -sign_;
-  return *this;
+std::optional<int64_t> BigInteger::TryToInt64() const {
+  return ToSigned<int64_t>(*this, INT64_MAX);
+}
+
+std::optional<uint64_t> BigInteger::TryToUInt64() const {
+  std::optional<unsigned __int128> magnitude = Magnitude(*this);
+  if (sign_ < 0 || !magnitude || *magnitude > UINT64_MAX) {
+    return std::nullopt;
+  }
+  return static_cast<uint64_t>(*magnitude);
+}
+
+std::optional<__int128> BigInteger::TryToInt128() const {
+  return ToSigned<__int128>(*this,
+                            static_cast<unsigned __int128>(-1) >> 1);
+}
+
+int64_t BigInteger::ToInt64() const {
+  std::optional<int64_t> short_number = TryToInt64();
+  if (!short_number) {
+    throw std::runtime_error("int64_t overflow");
+  }
+  return *short_number;
+}
+
+uint64_t BigInteger::ToUInt64() const {
+  std::optional<uint64_t> short_number = TryToUInt64();
+  if (!short_number) {
+    throw std::runtime_error("uint64_t overflow");
+  }
+  return *short_number;
 }
 
-BigInteger BigInteger::abs() const {
-  BigInteger value_abs;
-  value_abs.sign_ = (sign_ < 0) ? 1 : sign_;
-  value_abs.digits_ = digits_;
-  return value_abs;
+__int128 BigInteger::ToInt128() const {
+  std::optional<__int128> short_number = TryToInt128();
+  if (!short_number) {
+    throw std::runtime_error("__int128 overflow");
+  }
+  return *short_number;
 }
 
-void BigInteger::Abs() {
-  sign_ = (sign_ < 0) ? 1 : sign_;
+double BigInteger::ToDouble() const {
+  uint64_t length = BitLength();
+  if (length <= 64) {
+    double magnitude = static_cast<double>(
+        static_cast<uint64_t>(*Magnitude(*this)));
+    return (sign_ < 0) ? -magnitude : magnitude;
+  }
+  // The highest 64 bits keep 11 bits below the 53 bits of the result,
+  // and the lowest of them is set if any of the dropped bits is. So the
+  // conversion of this word rounds exactly as the whole number would.
+  uint64_t shift = length - 64;
+  size_t limb = shift / 32;
+  unsigned __int128 window = 0;
+  for (size_t i = digits_.size(); i-- > limb;) {
+    window = (window << 32) | digits_[i];
+  }
+  uint64_t top = static_cast<uint64_t>(window >> (shift % 32));
+  if (CountTrailingZeros() < shift) {
+    top |= 1;
+  }
+  if (shift > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+    shift = std::numeric_limits<int>::max();
+  }
+  double magnitude = std::ldexp(static_cast<double>(top),
+                                static_cast<int>(shift));
+  return (sign_ < 0) ? -magnitude : magnitude;
 }
 
 // HELP-FUNCTIONS
@@ -94,59 +165,34 @@ char BigInteger::IntToChar(int n) {
   return n - 10 + 'a';
 }
 
-int BigInteger::NextDigit(std::vector<int>& current_num, int its_base,
-                          int default_base = BigInteger::internal_base) {
-  int temp = 0;
-  for (int& i : current_num) {
+uint32_t BigInteger::NextDigit(std::vector<uint32_t>& current_num,
+                               uint64_t its_base,
+                               uint64_t default_base =
+                                   BigInteger::internal_base) {
+  uint64_t temp = 0;
+  for (uint32_t& i : current_num) {
     temp = temp * its_base + i;
-    i = temp / default_base;
+    i = static_cast<uint32_t>(temp / default_base);
     temp %= default_base;
   }
-  return temp;
+  return static_cast<uint32_t>(temp);
 }
 
-bool IsZero(const std::vector<int>& array) {
-  if (std::all_of(array.begin(), array.end(), [](int a) { return a == 0; })) {
+bool IsZero(const std::vector<uint32_t>& array) {
+  if (std::all_of(array.begin(), array.end(),
+                  [](uint32_t a) { return a == 0; })) {
     return true;
   }
   return false;
 }
 
-void BigInteger::CleanLeadZeroes() {
-  size_t num_of_zeroes = 0;
-  for (size_t i = 0; i < digits_.size(); ++i) {
-    if (digits_.at(digits_.size() - i - 1) == 0) {
-      num_of_zeroes++;
-    } else {
-      break;
-    }
-  }
-  digits_.erase(digits_.end() - num_of_zeroes,
-                digits_.end());
-  if (digits_.empty()) {
-    digits_.push_back(0);
-  }
-}
-
-void BigInteger::ReverseDigits() {
-  for (int i = 0; i < digits_.size() / 2; i++) {
-    std::swap(digits_.at(i),
-              digits_.at(digits_.size() - 1 - i));
-  }
-}
-
-int BigInteger::GetDigit(const std::vector<int>& array_of_digits,
-                         long long index) {
-  return (index < array_of_digits.size()) ? array_of_digits.at(index) : 0;
-}
-
 // STRING PROCESSING
 
 BigInteger BigInteger::FromString(const std::string& str, int base) {
   if ((base < 2) || (base > 36)) {
     throw std::logic_error("Invalid base");
   }
-  for (long long i = (str.at(0) == '-') ? 1 : 0; i < str.size(); i++) {
+  for (size_t i = (str.at(0) == '-') ? 1 : 0; i < str.size(); i++) {
     if (!((str[i] >= '0' && str[i] < IntToChar(base) && str[i] <= '9') ||
         (str[i] >= 'a' && str[i] < IntToChar(base) && str[i] <= 'z'))) {
       throw std::runtime_error("Invalid symbol at index " +
@@ -161,18 +207,15 @@ BigInteger BigInteger::FromString(const std::string& str, int base) {
     number.sign_ = 1;
   }
 
-  std::vector<int> temp_array;
-  for (long long i = (str.at(0) == '-') ? 1 : 0; i < str.size(); i++) {
+  std::vector<uint32_t> temp_array;
+  for (size_t i = (str.at(0) == '-') ? 1 : 0; i < str.size(); i++) {
     temp_array.push_back(CharToInt(str.at(i)));
   }
   do {
     number.digits_.push_back(NextDigit(temp_array, base));
   } while (!IsZero(temp_array));
   number.CleanLeadZeroes();
-
-  if (number.digits_.at(number.digits_.size() - 1) == 0) {
-    number.sign_ = 0;
-  }
+  BIG_INTEGER_COUNT(kFromString, number.digits_.size(), 2);
   return number;
 }
 
@@ -180,12 +223,13 @@ std::string BigInteger::ToString(int base) const {
   if (base < 2 || base > 36) {
     throw std::logic_error("Invalid base");
   }
-  std::vector<int> temp_array = digits_;
-  for (long long i = 0; i < temp_array.size() / 2; i++) {
+  BIG_INTEGER_COUNT(kToString, digits_.size(), 3);
+  std::vector<uint32_t> temp_array = digits_;
+  for (size_t i = 0; i < temp_array.size() / 2; i++) {
     std::swap(temp_array.at(i),
               temp_array.at(temp_array.size() - 1 - i));
   }
-  std::vector<int> result;
+  std::vector<uint32_t> result;
   do {
     result.push_back(NextDigit(temp_array,
                                BigInteger::internal_base, base));
@@ -205,434 +249,1594 @@ std::string BigInteger::ToString(int base) const {
   return fin_str;
 }
 
-// COMPARING TWO BIG INTEGERS
+// DIVISION
 
-bool BigInteger::operator==(const BigInteger& big_int_rhs) const {
-  if (sign_ != big_int_rhs.sign_ ||
-      digits_.size() != big_int_rhs.digits_.size()) {
-    return false;
+namespace {
+
+// Divisors of at least this many digits are divided recursively, so that
+// most of the work is done by big multiplications.
+const size_t kRecursiveDivisionThreshold = 64;
+
+// Exact division is quadratic, so when both the divisor and the quotient
+// have at least this many digits the recursive division is faster.
+const size_t kExactDivisionThreshold = 1024;
+
+// VALUE * B^count, where B is BigInteger::internal_base.
+BigInteger ShiftLimbs(const BigInteger& value, size_t count) {
+  if (value.Sign() == 0) {
+    return value;
   }
-  for (size_t i = 0; i < digits_.size(); i++) {
-    if (digits_.at(i) != big_int_rhs.digits_.at(i)) {
-      return false;
-    }
+  BIG_INTEGER_COUNT_ALLOCATIONS(kDivide, value.Limbs().size() + count, 2);
+  std::vector<uint32_t> digits(count, 0);
+  digits.insert(digits.end(), value.Limbs().begin(), value.Limbs().end());
+  return BigInteger::FromLimbs(digits.data(), digits.size());
+}
+
+// VALUE mod B^count for VALUE >= 0.
+BigInteger LowLimbs(const BigInteger& value, size_t count) {
+  BIG_INTEGER_COUNT_ALLOCATIONS(kDivide, value.Limbs().size(), 1);
+  return BigInteger::FromLimbs(value.Limbs().data(),
+                               std::min(count, value.Limbs().size()));
+}
+
+// VALUE div B^count for VALUE >= 0.
+BigInteger HighLimbs(const BigInteger& value, size_t count) {
+  if (value.Limbs().size() <= count) {
+    return BigInteger();
   }
-  return true;
+  return BigInteger::FromLimbs(value.Limbs().data() + count,
+                               value.Limbs().size() - count);
 }
 
-bool BigInteger::operator<=(const BigInteger& big_int_rhs) const {
-  if (sign_ < big_int_rhs.sign_) {
-    return true;
-  } else if (sign_ > big_int_rhs.sign_) {
-    return false;
-  } else if (digits_.size() != big_int_rhs.digits_.size()) {
-    if (sign_ > 0) {
-      return digits_.size() < big_int_rhs.digits_.size();
+// VALUE * 2^shift or VALUE / 2^shift for VALUE >= 0 and 0 <= shift < 32.
+BigInteger ShiftBits(const BigInteger& value, unsigned shift, bool left) {
+  BIG_INTEGER_COUNT_ALLOCATIONS(kDivide, value.Limbs().size(), 2);
+  std::vector<uint32_t> digits = value.Limbs();
+  if (left) {
+    digits.push_back(kernels::ShiftLeft(digits.data(), digits.size(), shift,
+                                        digits.data()));
+  } else {
+    kernels::ShiftRight(digits.data(), digits.size(), shift, digits.data());
+  }
+  return BigInteger::FromLimbs(digits.data(), digits.size());
+}
+
+// Division of NUMERATOR >= 0 by a DIVISOR > 0 of at least two digits with
+// the highest bit set.
+void SchoolbookDivide(const BigInteger& numerator, const BigInteger& divisor,
+                      BigInteger& quotient, BigInteger& remainder) {
+  const std::vector<uint32_t>& divisor_digits = divisor.Limbs();
+  if (numerator.Limbs().size() < divisor_digits.size()) {
+    quotient = BigInteger();
+    remainder = numerator;
+    return;
+  }
+  BIG_INTEGER_COUNT_ALLOCATIONS(kDivide, numerator.Limbs().size(), 4);
+  std::vector<uint32_t> digits = numerator.Limbs();
+  digits.push_back(0);
+  std::vector<uint32_t> quotient_digits(digits.size() -
+                                        divisor_digits.size());
+  kernels::SchoolbookDivide(digits.data(), digits.size(),
+                            divisor_digits.data(), divisor_digits.size(),
+                            quotient_digits.data());
+  quotient = BigInteger::FromLimbs(quotient_digits.data(),
+                                   quotient_digits.size());
+  remainder = BigInteger::FromLimbs(digits.data(), divisor_digits.size());
+}
+
+// Recursive division from "Modern Computer Arithmetic" by Brent and
+// Zimmermann (algorithm 1.8): the quotient is found by halves, and each
+// half costs one division of half the size and one product Q * B0.
+// Requires the same DIVISOR as SchoolbookDivide() and a quotient having
+// at most as many digits as DIVISOR.
+void RecursiveDivide(const BigInteger& numerator, const BigInteger& divisor,
+                     BigInteger& quotient, BigInteger& remainder) {
+  size_t divisor_size = divisor.Limbs().size();
+  size_t numerator_size = numerator.Limbs().size();
+  if (numerator_size < divisor_size + kRecursiveDivisionThreshold ||
+      divisor_size < kRecursiveDivisionThreshold) {
+    SchoolbookDivide(numerator, divisor, quotient, remainder);
+    return;
+  }
+  size_t half = (numerator_size - divisor_size) / 2;
+  // The three calls of HighLimbs(), which is shared with HalfGcd().
+  BIG_INTEGER_COUNT_ALLOCATIONS(kDivide, numerator_size, 3);
+  BigInteger divisor_high = HighLimbs(divisor, half);
+  BigInteger divisor_low = LowLimbs(divisor, half);
+
+  BigInteger quotient_high;
+  BigInteger remainder_high;
+  RecursiveDivide(HighLimbs(numerator, 2 * half), divisor_high,
+                  quotient_high, remainder_high);
+  BigInteger rest = ShiftLimbs(remainder_high, 2 * half) +
+      LowLimbs(numerator, 2 * half) -
+      ShiftLimbs(quotient_high * divisor_low, half);
+  while (rest < 0) {
+    quotient_high -= 1;
+    rest += ShiftLimbs(divisor, half);
+  }
+
+  BigInteger quotient_low;
+  BigInteger remainder_low;
+  RecursiveDivide(HighLimbs(rest, half), divisor_high,
+                  quotient_low, remainder_low);
+  remainder = ShiftLimbs(remainder_low, half) + LowLimbs(rest, half) -
+      quotient_low * divisor_low;
+  while (remainder < 0) {
+    quotient_low -= 1;
+    remainder += divisor;
+  }
+  quotient = ShiftLimbs(quotient_high, half) + quotient_low;
+}
+
+// Division of NUMERATOR >= 0 by DIVISOR > 0.
+void DivideMagnitudes(const BigInteger& numerator, const BigInteger& divisor,
+                      BigInteger& quotient, BigInteger& remainder) {
+  const std::vector<uint32_t>& divisor_digits = divisor.Limbs();
+  // Read by the instrumentation only.
+  [[maybe_unused]] size_t size =
+      numerator.Limbs().size() + divisor_digits.size();
+  if (divisor_digits.size() == 1) {
+    BIG_INTEGER_COUNT(kDivide, size, 3);
+    std::vector<uint32_t> digits = numerator.Limbs();
+    uint64_t rest = 0;
+    for (size_t i = digits.size(); i-- > 0;) {
+      uint64_t current_digit = (rest << 32) | digits[i];
+      digits[i] = static_cast<uint32_t>(current_digit / divisor_digits[0]);
+      rest = current_digit % divisor_digits[0];
     }
-    return digits_.size() > big_int_rhs.digits_.size();
+    quotient = BigInteger::FromLimbs(digits.data(), digits.size());
+    remainder = BigInteger(static_cast<int64_t>(rest));
+    return;
   }
 
-  for (long long i = digits_.size() - 1; i >= 0; i--) {
-    if (sign_ * (digits_.at(i) - big_int_rhs.digits_.at(i)) < 0) {
-      return true;
-    } else if (sign_ * (digits_.at(i) - big_int_rhs.digits_.at(i))
-        > 0) {
-      return false;
-    } else {
-      continue;
+  BIG_INTEGER_COUNT(kDivide, size, 0);
+  // The estimates of quotient digits need the highest bit of the divisor.
+  unsigned shift = std::countl_zero(divisor_digits.back());
+  BigInteger shifted_numerator = ShiftBits(numerator, shift, true);
+  BigInteger shifted_divisor = ShiftBits(divisor, shift, true);
+  size_t divisor_size = shifted_divisor.Limbs().size();
+  if (divisor_size < kRecursiveDivisionThreshold) {
+    SchoolbookDivide(shifted_numerator, shifted_divisor, quotient, remainder);
+  } else {
+    // Long division by blocks of divisor_size digits; every step divides
+    // at most 2 * divisor_size digits and gives one block of the quotient.
+    size_t blocks = (shifted_numerator.Limbs().size() + divisor_size - 1) /
+        divisor_size;
+    BIG_INTEGER_COUNT_ALLOCATIONS(kDivide, size, blocks + 2);
+    std::vector<uint32_t> quotient_digits(blocks * divisor_size, 0);
+    for (size_t block = blocks; block-- > 0;) {
+      BigInteger current = ShiftLimbs(remainder, divisor_size) + LowLimbs(
+          HighLimbs(shifted_numerator, block * divisor_size), divisor_size);
+      BigInteger block_quotient;
+      RecursiveDivide(current, shifted_divisor, block_quotient, remainder);
+      std::copy(block_quotient.Limbs().begin(), block_quotient.Limbs().end(),
+                quotient_digits.begin() + block * divisor_size);
     }
+    quotient = BigInteger::FromLimbs(quotient_digits.data(),
+                                     quotient_digits.size());
   }
-  return true;
+  remainder = ShiftBits(remainder, shift, false);
 }
 
-bool BigInteger::operator>=(const BigInteger& big_int_rhs) const {
-  if (sign_ > big_int_rhs.sign_) {
-    return true;
-  } else if (sign_ < big_int_rhs.sign_) {
-    return false;
-  } else if (digits_.size() != big_int_rhs.digits_.size()) {
-    if (sign_ > 0) {
-      return big_int_rhs.digits_.size() < digits_.size();
-    }
-    return big_int_rhs.digits_.size() > digits_.size();
+}  // namespace
+
+void BigInteger::SetExecutor(Executor* executor) {
+  kernels::SetExecutor(executor);
+}
+
+BigInteger BigInteger::operator/(const BigInteger& big_int_rhs) const {
+  if (big_int_rhs.sign_ == 0) {
+    throw DivisionByZeroError{};
+  }
+  if (digits_.size() < big_int_rhs.digits_.size()) {
+    return BigInteger(0);
+  }
+  BigInteger quotient;
+  BigInteger remainder;
+  DivideMagnitudes((*this).abs(), big_int_rhs.abs(), quotient, remainder);
+  if (sign_ * big_int_rhs.sign_ < 0) {
+    quotient.Negate();
   }
+  return quotient;
+}
 
-  for (long long i = digits_.size() - 1; i >= 0; i--) {
-    if (sign_ * (digits_.at(i) - big_int_rhs.digits_.at(i)) > 0) {
-      return true;
-    } else if (sign_ * (digits_.at(i) - big_int_rhs.digits_.at(i))
-        < 0) {
-      return false;
-    } else {
-      continue;
-    }
+// OPERATIONS WITH SHORT NUMBERS
+
+BigInteger BigInteger::operator/(int64_t short_number) const {
+  if (short_number == 0) {
+    throw DivisionByZeroError{};
   }
-  return true;
+  uint64_t short_number_abs = (short_number < 0)
+      ? uint64_t{0} - static_cast<uint64_t>(short_number)
+      : static_cast<uint64_t>(short_number);
+  if (short_number_abs >= internal_base) {
+    return (*this) / BigInteger(short_number);
+  }
+  BigInteger division;
+  division.sign_ = (short_number < 0) ? -sign_ : sign_;
+  uint64_t reminder = 0;
+  std::vector<uint32_t> temp_array = digits_;
+  for (size_t i = digits_.size(); i-- > 0;) {
+    uint64_t current_digit = temp_array.at(i) + reminder * internal_base;
+    temp_array.at(i) = static_cast<uint32_t>(current_digit / short_number_abs);
+    reminder = current_digit % short_number_abs;
+  }
+  division.digits_ = temp_array;
+  division.CleanLeadZeroes();
+  return division;
 }
 
-bool BigInteger::operator<(const BigInteger& big_int_rhs) const {
-  return !(*this >= big_int_rhs);
+BigInteger operator/(int64_t short_int, const BigInteger& big_int) {
+  if (big_int.sign_ == 0) {
+    throw DivisionByZeroError{};
+  }
+  return BigInteger(short_int) / big_int;
+}
+
+void BigInteger::operator/=(const BigInteger& big_int_rhs) {
+  if (big_int_rhs == BigInteger(0)) {
+    throw DivisionByZeroError{};
+  }
+  (*this) = *this / big_int_rhs;
+}
+
+void BigInteger::operator/=(int64_t short_number) {
+  if (short_number == 0) {
+    throw DivisionByZeroError{};
+  }
+  (*this) = (*this) / BigInteger(short_number);
+}
+
+BigInteger BigInteger::DivExact(const BigInteger& numerator,
+                                const BigInteger& divisor) {
+  if (divisor.sign_ == 0) {
+    throw DivisionByZeroError{};
+  }
+  // The kernel needs an odd divisor: a factor 2^k of the divisor divides
+  // the numerator as well, so both lose it.
+  uint64_t zeros = divisor.CountTrailingZeros();
+  BigInteger odd_divisor;
+  BigInteger rest;
+  const BigInteger* odd_divisor_ptr = &divisor;
+  const BigInteger* rest_ptr = &numerator;
+  if (zeros != 0) {
+    odd_divisor = divisor >> zeros;
+    rest = numerator >> zeros;
+    odd_divisor_ptr = &odd_divisor;
+    rest_ptr = &rest;
+  }
+  const std::vector<uint32_t>& divisor_digits = odd_divisor_ptr->digits_;
+  const std::vector<uint32_t>& rest_digits = rest_ptr->digits_;
+  if (rest_digits.size() < divisor_digits.size()) {
+    return BigInteger();
+  }
+  size_t quotient_size = rest_digits.size() - divisor_digits.size() + 1;
+  if (std::min(quotient_size, divisor_digits.size()) >=
+      kExactDivisionThreshold) {
+    return numerator / divisor;
+  }
+  BIG_INTEGER_COUNT(kDivide, rest_digits.size() + divisor_digits.size(), 1);
+  BigInteger quotient;
+  quotient.sign_ = numerator.sign_ * divisor.sign_;
+  quotient.digits_.assign(rest_digits.begin(),
+                          rest_digits.begin() + quotient_size);
+  kernels::DivideExact(quotient.digits_.data(), quotient_size,
+                       divisor_digits.data(), divisor_digits.size(),
+                       quotient.digits_.data());
+  quotient.CleanLeadZeroes();
+  return quotient;
+}
+
+BigInteger BigInteger::operator%(uint32_t short_number) const {
+  if (short_number == 0) {
+    throw DivisionByZeroError{};
+  }
+  uint32_t reduce = kernels::RemainderByDigit(digits_.data(), digits_.size(),
+                                              short_number);
+  if (sign_ < 0 && reduce != 0) {
+    reduce = short_number - reduce;
+  }
+  return BigInteger(reduce);
 }
 
-bool BigInteger::operator>(const BigInteger& big_int_rhs) const {
-  return !(*this <= big_int_rhs);
+// BIT OPERATIONS
+
+namespace {
+
+// 2^(32 size) - DIGITS, in place: the two's complement of the digits.
+void NegateDigits(uint32_t* digits, size_t size) {
+  uint64_t carry = 1;
+  for (size_t i = 0; i < size; ++i) {
+    carry += static_cast<uint32_t>(~digits[i]);
+    digits[i] = static_cast<uint32_t>(carry);
+    carry >>= 32;
+  }
 }
 
-bool BigInteger::operator!=(const BigInteger& big_int_rhs) const {
-  return !((*this) == big_int_rhs);
+// Lowest size digits of the two's complement of VALUE.
+std::vector<uint32_t> TwosComplement(const BigInteger& value, size_t size) {
+  std::vector<uint32_t> digits = value.Limbs();
+  digits.resize(size, 0);
+  if (value.Sign() < 0) {
+    NegateDigits(digits.data(), size);
+  }
+  return digits;
 }
 
-// COMPARING BIG INTEGER AND SHORT NUMBER
+// The number whose two's complement is DIGITS; the highest bit of the
+// highest digit is the sign.
+BigInteger FromTwosComplement(std::vector<uint32_t> digits) {
+  bool negative = !digits.empty() && (digits.back() >> 31) != 0;
+  if (negative) {
+    NegateDigits(digits.data(), digits.size());
+  }
+  BigInteger value = BigInteger::FromLimbs(digits.data(), digits.size());
+  if (negative) {
+    value.Negate();
+  }
+  return value;
+}
+
+// Applies OPERATION to every pair of digits of the two's complements. One
+// more digit than the longer operand has holds the sign of both.
+template<typename Operation>
+BigInteger BitwiseOperation(const BigInteger& lhs, const BigInteger& rhs,
+                            Operation operation) {
+  size_t size = std::max(lhs.Limbs().size(), rhs.Limbs().size()) + 1;
+  std::vector<uint32_t> digits = TwosComplement(lhs, size);
+  std::vector<uint32_t> rhs_digits = TwosComplement(rhs, size);
+  for (size_t i = 0; i < size; ++i) {
+    digits[i] = operation(digits[i], rhs_digits[i]);
+  }
+  return FromTwosComplement(std::move(digits));
+}
 
-bool BigInteger::operator==(int64_t short_number) const {
-  return (*this) == BigInteger(short_number);
+}  // namespace
+
+BigInteger BigInteger::operator<<(uint64_t shift) const {
+  if (sign_ == 0) {
+    return BigInteger();
+  }
+  // -(|x| * 2^k) is exactly the two's complement shift, so only the
+  // magnitude is shifted.
+  size_t limb_shift = shift / 32;
+  std::vector<uint32_t> digits(limb_shift, 0);
+  digits.insert(digits.end(), digits_.begin(), digits_.end());
+  digits.push_back(kernels::ShiftLeft(digits.data() + limb_shift,
+                                      digits_.size(), shift % 32,
+                                      digits.data() + limb_shift));
+  BigInteger result = FromLimbs(digits.data(), digits.size());
+  result.sign_ = sign_;
+  return result;
 }
 
-bool BigInteger::operator!=(int64_t short_number) const {
-  return (*this) != BigInteger(short_number);
+BigInteger BigInteger::operator>>(uint64_t shift) const {
+  if (shift >= BitLength()) {
+    return BigInteger((sign_ < 0) ? -1 : 0);
+  }
+  size_t limb_shift = shift / 32;
+  std::vector<uint32_t> digits(digits_.begin() + limb_shift, digits_.end());
+  kernels::ShiftRight(digits.data(), digits.size(), shift % 32,
+                      digits.data());
+  BigInteger result = FromLimbs(digits.data(), digits.size());
+  if (sign_ < 0) {
+    // Rounding towards minus infinity: a negative number loses one more
+    // unit, if any of the shifted out bits was set.
+    result.Negate();
+    if (CountTrailingZeros() < shift) {
+      result -= 1;
+    }
+  }
+  return result;
 }
 
-bool BigInteger::operator<=(int64_t short_number) const {
-  return (*this) <= BigInteger(short_number);
+BigInteger BigInteger::operator&(const BigInteger& big_int_rhs) const {
+  return BitwiseOperation(*this, big_int_rhs, [](uint32_t lhs, uint32_t rhs) {
+    return lhs & rhs;
+  });
 }
 
-bool BigInteger::operator<(int64_t short_number) const {
-  return (*this) < BigInteger(short_number);
+BigInteger BigInteger::operator|(const BigInteger& big_int_rhs) const {
+  return BitwiseOperation(*this, big_int_rhs, [](uint32_t lhs, uint32_t rhs) {
+    return lhs | rhs;
+  });
 }
 
-bool BigInteger::operator>(int64_t short_number) const {
-  return (*this) > BigInteger(short_number);
+BigInteger BigInteger::operator^(const BigInteger& big_int_rhs) const {
+  return BitwiseOperation(*this, big_int_rhs, [](uint32_t lhs, uint32_t rhs) {
+    return lhs ^ rhs;
+  });
 }
 
-bool BigInteger::operator>=(int64_t short_number) const {
-  return (*this) >= BigInteger(short_number);
+BigInteger BigInteger::operator~() const {
+  return -(*this) - 1;
 }
 
-bool operator==(int64_t short_int, const BigInteger& big_int) {
-  return big_int == short_int;
+void BigInteger::operator<<=(uint64_t shift) {
+  (*this) = (*this) << shift;
 }
 
-bool operator!=(int64_t short_int, const BigInteger& big_int) {
-  return big_int != short_int;
+void BigInteger::operator>>=(uint64_t shift) {
+  (*this) = (*this) >> shift;
 }
 
-bool operator<=(int64_t short_int, const BigInteger& big_int) {
-  return big_int >= short_int;
+void BigInteger::operator&=(const BigInteger& big_int_rhs) {
+  (*this) = (*this) & big_int_rhs;
 }
 
-bool operator<(int64_t short_int, const BigInteger& big_int) {
-  return big_int > short_int;
+void BigInteger::operator|=(const BigInteger& big_int_rhs) {
+  (*this) = (*this) | big_int_rhs;
 }
 
-bool operator>(int64_t short_int, const BigInteger& big_int) {
-  return big_int < short_int;
+void BigInteger::operator^=(const BigInteger& big_int_rhs) {
+  (*this) = (*this) ^ big_int_rhs;
 }
 
-bool operator>=(int64_t short_int, const BigInteger& big_int) {
-  return big_int <= short_int;
+uint64_t BigInteger::BitLength() const {
+  if (digits_.empty()) {
+    return 0;
+  }
+  return uint64_t{32} * (digits_.size() - 1) + std::bit_width(digits_.back());
 }
 
-// BINARY OPERATIONS
+uint64_t BigInteger::PopCount() const {
+  uint64_t count = 0;
+  for (uint32_t digit : digits_) {
+    count += std::popcount(digit);
+  }
+  return count;
+}
 
-BigInteger BigInteger::UnsignedSum(const BigInteger& big_int_lhs,
-                                   const BigInteger& big_int_rhs) {
-  BigInteger sum;
-  int temp = 0;
-  for (long long i = 0;
-       i < std::max(big_int_rhs.digits_.size(),
-                    big_int_lhs.digits_.size());
-       i++) {
-    temp = temp + GetDigit(big_int_rhs.digits_, i)
-        + GetDigit(big_int_lhs.digits_, i);
-    sum.digits_.push_back(temp % internal_base);
-    temp /= internal_base;
+bool BigInteger::TestBit(uint64_t index) const {
+  if (index >= BitLength()) {
+    return sign_ < 0;
   }
-  if (temp != 0) {
-    sum.digits_.push_back(temp);
+  bool bit = ((digits_[index / 32] >> (index % 32)) & 1) != 0;
+  // Below the lowest one bit -x has the same zeros as x, the lowest one
+  // bit is kept, and all the higher bits are inverted.
+  if (sign_ < 0 && index > CountTrailingZeros()) {
+    return !bit;
   }
-  if (sum.digits_.at(sum.digits_.size() - 1) != 0) {
-    if (big_int_lhs.sign_ == 0) {
-      sum.sign_ = big_int_rhs.sign_;
-    } else {
-      sum.sign_ = big_int_lhs.sign_;
+  return bit;
+}
+
+uint64_t BigInteger::CountTrailingZeros() const {
+  for (size_t i = 0; i < digits_.size(); ++i) {
+    if (digits_[i] != 0) {
+      return uint64_t{32} * i + std::countr_zero(digits_[i]);
     }
   }
-  return sum;
+  return 0;
 }
 
-BigInteger BigInteger::UnsignedSubtract(const BigInteger& big_int_lhs,
-                                        const BigInteger& big_int_rhs) {
-  BigInteger subtract;
-  size_t index = 0;
-  int current_difference = 0;
-  int temp = 0;
-  while (index < big_int_rhs.digits_.size()) {
-    current_difference =
-        big_int_lhs.digits_.at(index) - big_int_rhs.digits_.at(index)
-            - temp;
-    if (current_difference < 0) {
-      current_difference += internal_base;
-      temp = 1;
-    } else {
-      temp = 0;
+// REDUCTIONS
+
+namespace {
+
+// Numbers above this bound are too large to sieve primes up to them.
+const uint64_t kBinomialSieveLimit = uint64_t{1} << 26;
+
+// Packs small factors into words, so that the product tree starts from
+// leaves of a full word instead of one leaf per factor.
+class FactorCollector {
+ public:
+  void Multiply(uint64_t factor) {
+    if (factor > std::numeric_limits<uint64_t>::max() / word_) {
+      leaves_.push_back(BigInteger(word_));
+      word_ = 1;
     }
-    subtract.digits_.push_back(current_difference);
-    ++index;
+    word_ *= factor;
   }
-  while (index < big_int_lhs.digits_.size()) {
-    current_difference = big_int_lhs.digits_.at(index) - temp;
-    if (current_difference < 0) {
-      current_difference += internal_base;
-    } else {
-      temp = 0;
+
+  std::vector<BigInteger> Finish() {
+    if (word_ != 1 || leaves_.empty()) {
+      leaves_.push_back(BigInteger(word_));
     }
-    if ((big_int_lhs.digits_.size() - 1 == index)
-        && (current_difference == 0)) {
-      break;
-    } else {
-      subtract.digits_.push_back(current_difference);
+    return std::move(leaves_);
+  }
+
+ private:
+  uint64_t word_{1};
+  std::vector<BigInteger> leaves_;
+};
+
+// Exponent of the prime in n!, by the Legendre formula.
+uint64_t FactorialExponent(uint64_t n, uint64_t prime) {
+  uint64_t exponent = 0;
+  while (n > 0) {
+    n /= prime;
+    exponent += n;
+  }
+  return exponent;
+}
+
+}  // namespace
+
+void BigInteger::AddMagnitude(const BigInteger& value) {
+  if (digits_.size() < value.digits_.size()) {
+    digits_.resize(value.digits_.size(), 0);
+  }
+  uint32_t carry = kernels::Add(digits_.data(), digits_.size(),
+                                value.digits_.data(), value.digits_.size(),
+                                digits_.data());
+  if (carry != 0) {
+    digits_.push_back(carry);
+  }
+  if (sign_ == 0) {
+    sign_ = value.sign_;
+  }
+}
+
+BigInteger BigInteger::ProductTree(std::vector<BigInteger> level,
+                                   Executor* executor) {
+  if (level.empty()) {
+    return BigInteger(1);
+  }
+  while (level.size() > 1) {
+    std::vector<BigInteger> next_level((level.size() + 1) / 2);
+    ParallelFor(executor, level.size() / 2, [&level, &next_level](size_t i) {
+      next_level[i] = level[2 * i] * level[2 * i + 1];
+    });
+    if (level.size() % 2 == 1) {
+      next_level.back() = std::move(level.back());
     }
-    ++index;
+    level = std::move(next_level);
   }
-  subtract.CleanLeadZeroes();
-  if (subtract.digits_.at(subtract.digits_.size() - 1) != 0) {
-    subtract.sign_ = big_int_lhs.sign_;
+  return std::move(level.front());
+}
+
+BigInteger BigInteger::Factorial(uint64_t n, Executor* executor) {
+  FactorCollector factors;
+  for (uint64_t i = 2; i <= n; ++i) {
+    factors.Multiply(i);
   }
-  return subtract;
+  return ProductTree(factors.Finish(), executor);
 }
 
-BigInteger BigInteger::operator+(const BigInteger& big_int_rhs) const {
-  if (sign_ == big_int_rhs.sign_) {
-    return UnsignedSum(*this, big_int_rhs);
-  } else if ((*this).abs() >= big_int_rhs.abs()) {
-    return UnsignedSubtract(*this, big_int_rhs);
+BigInteger BigInteger::Binomial(uint64_t n, uint64_t k, Executor* executor) {
+  if (k > n) {
+    return BigInteger(0);
+  }
+  k = std::min(k, n - k);
+  if (k == 0) {
+    return BigInteger(1);
+  }
+  // The k steps below cost about k^2 log(n) digit operations together and
+  // the sieve about n, so small k are not worth sieving up to n.
+  if (n > kBinomialSieveLimit ||
+      k * k * static_cast<uint64_t>(std::bit_width(n)) < n) {
+    // Every prefix product of (n - k + 1) ... (n - k + i) is divisible
+    // by i!, so each step is an exact division by a short number.
+    BigInteger result(1);
+    for (uint64_t i = 1; i <= k; ++i) {
+      result = result * BigInteger(n - k + i) / static_cast<int64_t>(i);
+    }
+    return result;
+  }
+
+  // Otherwise the result is built from its prime factorization, which
+  // needs no division at all.
+  std::vector<bool> is_composite(n + 1, false);
+  FactorCollector factors;
+  for (uint64_t prime = 2; prime <= n; ++prime) {
+    if (is_composite[prime]) {
+      continue;
+    }
+    for (uint64_t multiple = prime * prime; multiple <= n;
+         multiple += prime) {
+      is_composite[multiple] = true;
+    }
+    uint64_t exponent = FactorialExponent(n, prime) -
+        FactorialExponent(k, prime) - FactorialExponent(n - k, prime);
+    for (uint64_t i = 0; i < exponent; ++i) {
+      factors.Multiply(prime);
+    }
+  }
+  return ProductTree(factors.Finish(), executor);
+}
+
+// GREATEST COMMON DIVISOR
+
+namespace {
+
+// Pairs with at least this many digits are reduced by the half-gcd
+// recursion, shorter ones by Lehmer steps.
+const size_t kHalfGcdThreshold = 512;
+
+// Cofactors of a reduction: (a; b) = M (a'; b') for the pair (a, b) it
+// started from and the pair (a', b') it came to. M is a product of steps
+// with determinants 1 or -1, so M^-1 has integer entries as well.
+struct CofactorMatrix {
+  // M = M * [[p00, p01], [p10, p11]], where the step has the determinant.
+  void Multiply(const BigInteger& p00, const BigInteger& p01,
+                const BigInteger& p10, const BigInteger& p11,
+                int step_determinant) {
+    BigInteger new_m00 = m00 * p00 + m01 * p10;
+    BigInteger new_m01 = m00 * p01 + m01 * p11;
+    BigInteger new_m10 = m10 * p00 + m11 * p10;
+    m11 = m10 * p01 + m11 * p11;
+    m00 = std::move(new_m00);
+    m01 = std::move(new_m01);
+    m10 = std::move(new_m10);
+    determinant *= step_determinant;
+  }
+
+  void Multiply(const CofactorMatrix& step) {
+    Multiply(step.m00, step.m01, step.m10, step.m11, step.determinant);
   }
-  return UnsignedSubtract(big_int_rhs, *this);
+
+  // The pair (a', b') became (-a', b') or (a', -b').
+  void NegateColumn(int column) {
+    BigInteger& top = (column == 0) ? m00 : m01;
+    BigInteger& bottom = (column == 0) ? m10 : m11;
+    top.Negate();
+    bottom.Negate();
+    determinant = -determinant;
+  }
+
+  // The pair (a', b') became (b', a').
+  void SwapColumns() {
+    std::swap(m00, m01);
+    std::swap(m10, m11);
+    determinant = -determinant;
+  }
+
+  BigInteger m00{1};
+  BigInteger m01;
+  BigInteger m10;
+  BigInteger m11{1};
+  int determinant{1};
+};
+
+uint64_t BinaryGcd(uint64_t lhs, uint64_t rhs) {
+  if (lhs == 0 || rhs == 0) {
+    return lhs | rhs;
+  }
+  int shift = std::countr_zero(lhs | rhs);
+  lhs >>= std::countr_zero(lhs);
+  while (rhs != 0) {
+    rhs >>= std::countr_zero(rhs);
+    if (lhs > rhs) {
+      std::swap(lhs, rhs);
+    }
+    rhs -= lhs;
+  }
+  return lhs << shift;
 }
 
-BigInteger BigInteger::operator-(const BigInteger& big_int_rhs) const {
-  if (sign_ == 0) {
-    BigInteger result = big_int_rhs;
-    return result.negate();
+// 63 bits of |VALUE| starting from the bit with the given index.
+uint64_t HighBits(const BigInteger& value, uint64_t shift) {
+  const std::vector<uint32_t>& digits = value.Limbs();
+  size_t limb = shift / 32;
+  unsigned __int128 window = 0;
+  for (size_t i = std::min(digits.size(), limb + 3); i-- > limb;) {
+    window = (window << 32) | digits[i];
   }
-  if (big_int_rhs.sign_ == 0) {
-    return (*this);
+  return static_cast<uint64_t>(window >> (shift % 32));
+}
+
+// LHS_FACTOR * |LHS| + RHS_FACTOR * |RHS| in a single pass over the digits.
+BigInteger LinearCombination(int64_t lhs_factor, const BigInteger& lhs,
+                             int64_t rhs_factor, const BigInteger& rhs) {
+  const std::vector<uint32_t>& lhs_digits = lhs.Limbs();
+  const std::vector<uint32_t>& rhs_digits = rhs.Limbs();
+  // Two more digits for the factors and one for the sign.
+  std::vector<uint32_t> digits(
+      std::max(lhs_digits.size(), rhs_digits.size()) + 3);
+  __int128 carry = 0;
+  for (size_t i = 0; i < digits.size(); ++i) {
+    if (i < lhs_digits.size()) {
+      carry += static_cast<__int128>(lhs_factor) * lhs_digits[i];
+    }
+    if (i < rhs_digits.size()) {
+      carry += static_cast<__int128>(rhs_factor) * rhs_digits[i];
+    }
+    digits[i] = static_cast<uint32_t>(carry);
+    carry >>= 32;
   }
-  if (sign_ != big_int_rhs.sign_) {
-    return UnsignedSum(*this, big_int_rhs);
+  return FromTwosComplement(std::move(digits));
+}
+
+// Restores a >= b >= 0 after a step that may have overshot.
+void Normalize(BigInteger& a, BigInteger& b, CofactorMatrix* matrix) {
+  if (a.Sign() < 0) {
+    a.Negate();
+    if (matrix != nullptr) {
+      matrix->NegateColumn(0);
+    }
   }
-  if ((*this).abs() >= big_int_rhs.abs()) {
-    return UnsignedSubtract(*this, big_int_rhs);
+  if (b.Sign() < 0) {
+    b.Negate();
+    if (matrix != nullptr) {
+      matrix->NegateColumn(1);
+    }
+  }
+  if (a < b) {
+    std::swap(a, b);
+    if (matrix != nullptr) {
+      matrix->SwapColumns();
+    }
   }
-  return UnsignedSubtract(big_int_rhs, *this).negate();
 }
 
+// One step of Euclid's algorithm, (a, b) becomes (b, a mod b).
+void DivisionStep(BigInteger& a, BigInteger& b, CofactorMatrix* matrix) {
+  BigInteger quotient;
+  BigInteger remainder;
+  DivideMagnitudes(a, b, quotient, remainder);
+  if (matrix != nullptr) {
+    matrix->Multiply(quotient, BigInteger(1), BigInteger(1), BigInteger(), -1);
+  }
+  a = std::move(b);
+  b = std::move(remainder);
+}
 
-BigInteger BigInteger::operator*(const BigInteger& big_int_rhs) const {
-  size_t first_size = big_int_rhs.digits_.size();
-  size_t second_size = digits_.size();
+size_t WordSize(uint64_t word) {
+  return (word == 0) ? 0 : (word >> 32 == 0) ? 1 : 2;
+}
 
-  BigInteger product;
-  product.sign_ = sign_ * big_int_rhs.sign_;
-  product.digits_.resize(first_size + second_size);
-  for (size_t i = 0; i < first_size; ++i) {
-    for (size_t j = 0; j < second_size; ++j) {
-      product.digits_.at(i + j) +=
-          big_int_rhs.digits_.at(i) * digits_.at(j);
+// Euclid's algorithm on words for a >= b >= 0 below 2^64, until b has at
+// most stop_size digits. The steps are gathered into a matrix of words,
+// whose entries never exceed a.
+void WordSteps(BigInteger& a, BigInteger& b, CofactorMatrix* matrix,
+               size_t stop_size) {
+  uint64_t lhs = a.ToUInt64();
+  uint64_t rhs = b.ToUInt64();
+  if (matrix == nullptr && stop_size == 0) {
+    a = BigInteger(BinaryGcd(lhs, rhs));
+    b = BigInteger();
+    return;
+  }
+  uint64_t p00 = 1;
+  uint64_t p01 = 0;
+  uint64_t p10 = 0;
+  uint64_t p11 = 1;
+  int determinant = 1;
+  while (WordSize(rhs) > stop_size) {
+    uint64_t quotient = lhs / rhs;
+    uint64_t remainder = lhs % rhs;
+    lhs = rhs;
+    rhs = remainder;
+    p01 = std::exchange(p00, p00 * quotient + p01);
+    p11 = std::exchange(p10, p10 * quotient + p11);
+    determinant = -determinant;
+  }
+  if (matrix != nullptr) {
+    matrix->Multiply(BigInteger(p00), BigInteger(p01), BigInteger(p10),
+                     BigInteger(p11), determinant);
+  }
+  a = BigInteger(lhs);
+  b = BigInteger(rhs);
+}
+
+// One step of Lehmer's algorithm (Knuth, TAOCP vol. 2, 4.5.2, algorithm
+// L) for a >= b > 0 and a >= 2^64: all the quotients that the highest 63
+// bits of a and b determine are applied to the whole numbers at once. If
+// they determine none, it makes a division step instead.
+void LehmerStep(BigInteger& a, BigInteger& b, CofactorMatrix* matrix) {
+  uint64_t shift = a.BitLength() - 63;
+  // (high_a; high_b) follows [[a_a, a_b], [b_a, b_b]] * (a; b).
+  __int128 high_a = HighBits(a, shift);
+  __int128 high_b = HighBits(b, shift);
+  __int128 a_a = 1;
+  __int128 a_b = 0;
+  __int128 b_a = 0;
+  __int128 b_b = 1;
+  int determinant = 1;
+  while (high_b + b_a > 0 && high_b + b_b > 0 && high_a + a_b >= 0) {
+    // The quotient of the true numbers lies between these two.
+    __int128 quotient = (high_a + a_a) / (high_b + b_a);
+    if (quotient != (high_a + a_b) / (high_b + b_b)) {
+      break;
     }
-    for (size_t j = 0; j < product.digits_.size(); ++j) {
-      if (product.digits_.at(j) > internal_base - 1) {
-        product.digits_.at(j + 1) +=
-            product.digits_.at(j) / internal_base;
-        product.digits_.at(j) %= internal_base;
-      }
+    a_a = std::exchange(b_a, a_a - quotient * b_a);
+    a_b = std::exchange(b_b, a_b - quotient * b_b);
+    high_a = std::exchange(high_b, high_a - quotient * high_b);
+    determinant = -determinant;
+  }
+  if (a_b == 0) {
+    DivisionStep(a, b, matrix);
+    return;
+  }
+
+  BigInteger new_a = LinearCombination(static_cast<int64_t>(a_a), a,
+                                       static_cast<int64_t>(a_b), b);
+  BigInteger new_b = LinearCombination(static_cast<int64_t>(b_a), a,
+                                       static_cast<int64_t>(b_b), b);
+  if (matrix != nullptr) {
+    // The inverse of [[a_a, a_b], [b_a, b_b]] has non-negative entries.
+    auto magnitude = [](__int128 value) {
+      return BigInteger(static_cast<uint64_t>((value < 0) ? -value : value));
+    };
+    matrix->Multiply(magnitude(b_b), magnitude(a_b), magnitude(b_a),
+                     magnitude(a_a), determinant);
+  }
+  a = std::move(new_a);
+  b = std::move(new_b);
+  Normalize(a, b, matrix);
+}
+
+// Lehmer steps for a >= b >= 0 until b has at most stop_size digits.
+void LehmerReduce(BigInteger& a, BigInteger& b, CofactorMatrix* matrix,
+                  size_t stop_size) {
+  while (b.Limbs().size() > stop_size) {
+    if (a.BitLength() <= 64) {
+      WordSteps(a, b, matrix, stop_size);
+      return;
     }
+    LehmerStep(a, b, matrix);
   }
-  product.CleanLeadZeroes();
-  return product;
 }
 
-BigInteger BigInteger::PowerOfTen(long long power, const BigInteger& value) {
-  BigInteger result;
-  result.sign_ = 1;
-  result.digits_.resize(power);
-  for (int digit : value.digits_) {
-    result.digits_.push_back(digit);
+// Reduces a >= b >= 0 of n digits until b has at most n / 2 + 1 digits
+// by the half-gcd recursion (Moller, "On Schonhage's algorithm and
+// subquadratic integer gcd computation"): the cofactors of the reduced
+// top digits are applied to the whole numbers, twice, so that the work
+// is done by big multiplications. Any unimodular M keeps the gcd, so a
+// last quotient that the top digits got wrong is repaired by Normalize().
+void HalfGcd(BigInteger& a, BigInteger& b, CofactorMatrix* matrix) {
+  size_t size = a.Limbs().size();
+  size_t stop_size = size / 2 + 1;
+  if (size < kHalfGcdThreshold) {
+    LehmerReduce(a, b, matrix, stop_size);
+    return;
   }
-  return result;
+  for (int round = 0; round < 2; ++round) {
+    if (b.Limbs().size() <= stop_size ||
+        a.Limbs().size() >= 2 * stop_size) {
+      break;
+    }
+    // The first round reduces the top half and leaves about 3n/4 digits,
+    // the second one takes just enough digits to come down to n/2.
+    size_t low_size = (round == 0) ? size / 2
+                                   : 2 * stop_size - a.Limbs().size();
+    BigInteger high_a = HighLimbs(a, low_size);
+    BigInteger high_b = HighLimbs(b, low_size);
+    CofactorMatrix cofactors;
+    HalfGcd(high_a, high_b, &cofactors);
+
+    // (a; b) = M^-1 (a; b) = det M * [[m11, -m01], [-m10, m00]] (a; b).
+    BigInteger new_a = cofactors.m11 * a - cofactors.m01 * b;
+    BigInteger new_b = cofactors.m00 * b - cofactors.m10 * a;
+    if (cofactors.determinant < 0) {
+      new_a.Negate();
+      new_b.Negate();
+    }
+    a = std::move(new_a);
+    b = std::move(new_b);
+    Normalize(a, b, &cofactors);
+    if (matrix != nullptr) {
+      matrix->Multiply(cofactors);
+    }
+    if (round == 0 && b.Limbs().size() > stop_size) {
+      DivisionStep(a, b, matrix);
+    }
+  }
+  LehmerReduce(a, b, matrix, stop_size);
 }
 
-int BigInteger::GetShortDivision(const BigInteger& temp_division,
-                                 const BigInteger& big_int_rhs) {
-  int64_t left = 0;
-  int64_t right = internal_base;
-  int64_t middle = 0;
-  int result;
-  while (left <= right) {
-    middle = (left + right) / 2;
-    BigInteger temp = middle * big_int_rhs;
-    if (temp_division >= temp) {
-      result = middle;
-      left = middle + 1;
+// Reduces a >= b >= 0 to (gcd(a, b), 0).
+void GcdReduce(BigInteger& a, BigInteger& b, CofactorMatrix* matrix) {
+  while (b.Sign() != 0) {
+    if (b.Limbs().size() < kHalfGcdThreshold) {
+      LehmerReduce(a, b, matrix, 0);
+    } else if (b.Limbs().size() <= a.Limbs().size() / 2 + 1) {
+      DivisionStep(a, b, matrix);
     } else {
-      right = middle - 1;
+      HalfGcd(a, b, matrix);
     }
   }
-  return result;
 }
 
-BigInteger BigInteger::operator/(const BigInteger& big_int_rhs) const {
-  if (IsZero(big_int_rhs.digits_)) {
-    throw DivisionByZeroError{};
+}  // namespace
+
+BigInteger BigInteger::Gcd(const BigInteger& big_int_lhs,
+                           const BigInteger& big_int_rhs) {
+  BigInteger a = big_int_lhs.abs();
+  BigInteger b = big_int_rhs.abs();
+  if (a < b) {
+    std::swap(a, b);
   }
-  if (IsZero(digits_) ||
-      (digits_.size() < big_int_rhs.digits_.size())) {
-    return BigInteger(0);
+  GcdReduce(a, b, nullptr);
+  return a;
+}
+
+BigInteger BigInteger::ExtendedGcd(const BigInteger& big_int_lhs,
+                                   const BigInteger& big_int_rhs,
+                                   BigInteger& lhs_factor,
+                                   BigInteger& rhs_factor) {
+  if (big_int_rhs.sign_ == 0) {
+    lhs_factor = BigInteger(big_int_lhs.sign_);
+    rhs_factor = BigInteger();
+    return big_int_lhs.abs();
   }
-  BigInteger result;
-  BigInteger division;
+  BigInteger a = big_int_lhs.abs();
+  BigInteger b = big_int_rhs.abs();
+  bool swapped = a < b;
+  if (swapped) {
+    std::swap(a, b);
+  }
+  CofactorMatrix cofactors;
+  GcdReduce(a, b, &cofactors);
+  BigInteger gcd = std::move(a);
+
+  // (gcd; 0) = M^-1 (a; b), so gcd = det M * (m11 a - m01 b).
+  BigInteger factor = cofactors.m11;
+  if (swapped) {
+    factor = -cofactors.m01;
+  }
+  if (cofactors.determinant * big_int_lhs.sign_ < 0) {
+    factor.Negate();
+  }
+  // Every LHS_FACTOR + k |RHS| / gcd works; the least non-negative one
+  // is taken.
+  BigInteger period = big_int_rhs.abs() / gcd;
+  BigInteger quotient;
+  BigInteger remainder;
+  DivideMagnitudes(factor.abs(), period, quotient, remainder);
+  if (factor.sign_ < 0 && remainder.sign_ != 0) {
+    remainder = period - remainder;
+  }
+  lhs_factor = std::move(remainder);
+  rhs_factor = (gcd - big_int_lhs * lhs_factor) / big_int_rhs;
+  return gcd;
+}
 
-  division.sign_ = 1;
-  division.digits_ = digits_;
-  BigInteger
-      current_big_rhs = PowerOfTen(digits_.size() -
-          big_int_rhs.digits_.size(), big_int_rhs);
-  for (long long i = digits_.size() - big_int_rhs.digits_.size(); i >= 0;
-                                                                      i--) {
-    int64_t digit = GetShortDivision(division, current_big_rhs);
-    result.digits_.push_back(digit);
-
-    division = division - current_big_rhs * digit;
-    current_big_rhs.digits_.erase(current_big_rhs.digits_.begin());
-  }
-  result.ReverseDigits();
-  result.CleanLeadZeroes();
-  result.sign_ = sign_ * big_int_rhs.sign_;
-  return result;
+BigInteger BigInteger::ModInverse(const BigInteger& big_int,
+                                  const BigInteger& modulus) {
+  if (modulus.sign_ == 0) {
+    throw DivisionByZeroError{};
+  }
+  BigInteger inverse;
+  BigInteger modulus_factor;
+  if (ExtendedGcd(big_int, modulus, inverse, modulus_factor) != 1) {
+    throw std::runtime_error("No modular inverse");
+  }
+  return inverse;
 }
 
-// OPERATIONS WITH SHORT NUMBERS
+// PRIMES
 
-BigInteger operator+(int64_t short_number, const BigInteger& big_int) {
-  BigInteger a(short_number);
-  return a + big_int;
-}
+namespace {
 
-BigInteger operator-(int64_t short_number, const BigInteger& big_int) {
-  return BigInteger(short_number) - big_int;
-}
+// Trial division takes the primes below this bound.
+const uint32_t kSmallPrimeLimit = 4096;
+// NextPrime() sieves candidates in windows of this many numbers.
+const size_t kSieveWindow = 4096;
 
-BigInteger BigInteger::operator+(int64_t short_number) const {
-  BigInteger a(short_number);
-  BigInteger res = (*this) + a;
-  return res;
+const std::vector<uint32_t>& SmallPrimes() {
+  static const std::vector<uint32_t> primes = [] {
+    std::vector<uint32_t> result;
+    std::vector<bool> is_composite(kSmallPrimeLimit, false);
+    for (uint32_t i = 2; i < kSmallPrimeLimit; ++i) {
+      if (!is_composite[i]) {
+        result.push_back(i);
+        for (uint32_t j = i * i; j < kSmallPrimeLimit; j += i) {
+          is_composite[j] = true;
+        }
+      }
+    }
+    return result;
+  }();
+  return primes;
+}
+
+// |VALUE| mod p for every small prime p. The primes are taken in groups
+// whose product fits into a digit, so each group costs one pass of the
+// single-digit remainder over the digits.
+std::vector<uint32_t> SmallPrimeRemainders(const BigInteger& value) {
+  const std::vector<uint32_t>& primes = SmallPrimes();
+  const std::vector<uint32_t>& digits = value.Limbs();
+  std::vector<uint32_t> remainders(primes.size());
+  size_t begin = 0;
+  while (begin < primes.size()) {
+    uint64_t product = 1;
+    size_t end = begin;
+    while (end < primes.size() && product * primes[end] <= UINT32_MAX) {
+      product *= primes[end++];
+    }
+    uint32_t remainder = kernels::RemainderByDigit(
+        digits.data(), digits.size(), static_cast<uint32_t>(product));
+    for (size_t i = begin; i < end; ++i) {
+      remainders[i] = remainder % primes[i];
+    }
+    begin = end;
+  }
+  return remainders;
 }
 
-BigInteger BigInteger::operator-(int64_t short_number) const {
-  BigInteger a(short_number);
-  BigInteger res = (*this) - a;
-  return res;
+// Jacobi symbol (a / n) for a small odd a and an odd n > 0.
+int Jacobi(int64_t a, const BigInteger& n) {
+  int result = 1;
+  if (a < 0) {
+    // (-1 / n) = -1 exactly for n = 3 mod 4.
+    a = -a;
+    if (n.TestBit(1)) {
+      result = -result;
+    }
+  }
+  // By the reciprocity law (a / n) = (n / a), unless both are 3 mod 4.
+  if ((a & 3) == 3 && n.TestBit(1)) {
+    result = -result;
+  }
+  // (n / a) = (n mod a / a), which needs only words.
+  uint64_t top = (n % static_cast<uint32_t>(a)).ToUInt64();
+  uint64_t bottom = static_cast<uint64_t>(a);
+  while (top != 0) {
+    while (top % 2 == 0) {
+      top /= 2;
+      if (bottom % 8 == 3 || bottom % 8 == 5) {
+        result = -result;
+      }
+    }
+    std::swap(top, bottom);
+    if (top % 4 == 3 && bottom % 4 == 3) {
+      result = -result;
+    }
+    top %= bottom;
+  }
+  return (bottom == 1) ? result : 0;
 }
 
-BigInteger BigInteger::operator*(int64_t short_number) const {
-  return (*this) * BigInteger(short_number);
+// Floor of the square root of VALUE >= 0, by Newton's iteration from
+// above.
+BigInteger FloorSqrt(const BigInteger& value) {
+  if (value.Sign() == 0) {
+    return value;
+  }
+  BigInteger root = BigInteger(1) << ((value.BitLength() + 1) / 2);
+  while (true) {
+    BigInteger next = (root + value / root) >> 1;
+    if (next >= root) {
+      return root;
+    }
+    root = std::move(next);
+  }
 }
 
-BigInteger operator*(int64_t short_number, const BigInteger& big_int) {
-  return BigInteger(short_number) * big_int;
+// Strong probable prime test of odd N > 3 (the modulus of the context) to
+// the base: with N - 1 = d 2^s, d odd, either base^d = 1 or one of the s
+// squarings of it gives -1.
+bool MillerRabin(ModContext& context, const BigInteger& base) {
+  BigInteger n_minus_one = context.Modulus() - 1;
+  uint64_t twos = n_minus_one.CountTrailingZeros();
+  BigInteger one = context.ToResidue(BigInteger(1));
+  BigInteger minus_one = context.ToResidue(n_minus_one);
+  BigInteger power = context.ToResidue(
+      context.PowMod(base, n_minus_one >> twos));
+  if (power == one || power == minus_one) {
+    return true;
+  }
+  for (uint64_t i = 1; i < twos; ++i) {
+    context.MulMod(power, power, power);
+    if (power == minus_one) {
+      return true;
+    }
+    if (power == one) {
+      return false;
+    }
+  }
+  return false;
 }
 
-BigInteger BigInteger::operator/(int64_t short_number) const {
-  if (short_number == 0) {
-    throw DivisionByZeroError{};
+// X / 2 for a residue modulo the odd modulus N.
+BigInteger Half(const BigInteger& residue, const BigInteger& n) {
+  return (residue.TestBit(0) ? residue + n : residue) >> 1;
+}
+
+// Strong Lucas probable prime test of odd N > 3, which is not a square,
+// with the parameters of Selfridge (method A): D is the first of 5, -7, 9,
+// -11, ... with (D / N) = -1, P = 1 and Q = (1 - D) / 4. With
+// N + 1 = d 2^s, d odd, either U_d = 0 or V_(d 2^r) = 0 for some r < s.
+bool StrongLucas(ModContext& context, int64_t d_value) {
+  const BigInteger& n = context.Modulus();
+  BigInteger d = context.ToResidue(BigInteger(d_value));
+  BigInteger q = context.ToResidue(BigInteger((1 - d_value) / 4));
+  BigInteger n_plus_one = n + 1;
+  uint64_t twos = n_plus_one.CountTrailingZeros();
+  BigInteger index = n_plus_one >> twos;
+
+  // U_1 = 1, V_1 = P = 1, Q^1 = Q, and the index grows by its bits.
+  BigInteger u = context.ToResidue(BigInteger(1));
+  BigInteger v = u;
+  BigInteger q_power = q;
+  BigInteger temp;
+  for (uint64_t bit = index.BitLength() - 1; bit-- > 0;) {
+    // U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k.
+    context.MulMod(u, v, u);
+    context.MulMod(v, v, v);
+    context.SubMod(v, q_power, v);
+    context.SubMod(v, q_power, v);
+    context.MulMod(q_power, q_power, q_power);
+    if (index.TestBit(bit)) {
+      // U_(k+1) = (P U_k + V_k) / 2, V_(k+1) = (D U_k + P V_k) / 2.
+      context.MulMod(d, u, temp);
+      context.AddMod(u, v, u);
+      u = Half(u, n);
+      context.AddMod(temp, v, v);
+      v = Half(v, n);
+      context.MulMod(q_power, q, q_power);
+    }
   }
-  BigInteger division;
-  int64_t short_number_abs;
-  if (short_number < 0) {
-    short_number_abs = -short_number;
-    division.sign_ = -sign_;
-  } else {
-    short_number_abs = short_number;
-    division.sign_ = sign_;
-  }
-  int64_t reminder = 0;
-  std::vector<int> temp_array = digits_;
-  for (long long i = digits_.size() - 1; i >= 0; --i) {
-    long long current_digit = temp_array.at(i) + reminder * internal_base;
-    temp_array.at(i) = current_digit / short_number_abs;
-    reminder = current_digit % short_number_abs;
+  if (u.Sign() == 0 || v.Sign() == 0) {
+    return true;
   }
-  division.digits_ = temp_array;
-  division.CleanLeadZeroes();
-  return division;
+  for (uint64_t i = 1; i < twos; ++i) {
+    context.MulMod(v, v, v);
+    context.SubMod(v, q_power, v);
+    context.SubMod(v, q_power, v);
+    if (v.Sign() == 0) {
+      return true;
+    }
+    context.MulMod(q_power, q_power, q_power);
+  }
+  return false;
 }
 
-BigInteger operator/(int64_t short_int, const BigInteger& big_int) {
-  if (big_int.sign_ == 0) {
-    throw DivisionByZeroError{};
+// The Baillie-PSW test of odd N, which has no factors below
+// kSmallPrimeLimit and is above its square.
+bool BailliePsw(const BigInteger& n) {
+  ModContext context(n);
+  if (!MillerRabin(context, BigInteger(2))) {
+    return false;
   }
-  return BigInteger(short_int) / big_int;
+  int64_t d_value = 5;
+  for (int attempt = 0;; ++attempt) {
+    int jacobi = Jacobi(d_value, n);
+    if (jacobi == -1) {
+      break;
+    }
+    if (jacobi == 0) {
+      // D has a common factor with N, and it is much smaller than N.
+      return false;
+    }
+    // No suitable D exists for squares, so they are ruled out once the
+    // search takes longer than usual.
+    if (attempt == 10) {
+      BigInteger root = FloorSqrt(n);
+      if (root * root == n) {
+        return false;
+      }
+    }
+    d_value = (d_value > 0) ? -(d_value + 2) : -(d_value - 2);
+  }
+  return StrongLucas(context, d_value);
 }
 
-void BigInteger::operator+=(const BigInteger& big_int_rhs) {
-  (*this) = (*this) + big_int_rhs;
+}  // namespace
+
+bool BigInteger::IsProbablePrime(int rounds, Executor* executor) const {
+  if (sign_ <= 0) {
+    return false;
+  }
+  const std::vector<uint32_t>& primes = SmallPrimes();
+  std::vector<uint32_t> remainders = SmallPrimeRemainders(*this);
+  for (size_t i = 0; i < primes.size(); ++i) {
+    if (remainders[i] == 0) {
+      return (*this) == primes[i];
+    }
+  }
+  if ((*this) < int64_t{kSmallPrimeLimit} * kSmallPrimeLimit) {
+    return (*this) != 1;
+  }
+  if (!BailliePsw(*this)) {
+    return false;
+  }
+
+  // Extra rounds are independent, so each of them gets a context of its
+  // own and may run on another thread.
+  size_t extra_rounds = std::min<size_t>(std::max(rounds, 0),
+                                         primes.size() - 1);
+  std::atomic<bool> composite{false};
+  ParallelFor(executor, extra_rounds, [this, &primes, &composite](size_t i) {
+    if (composite.load()) {
+      return;
+    }
+    ModContext context(*this);
+    if (!MillerRabin(context, BigInteger(primes[i + 1]))) {
+      composite.store(true);
+    }
+  });
+  return !composite.load();
 }
 
-void BigInteger::operator-=(const BigInteger& big_int_rhs) {
-  (*this) = (*this) - big_int_rhs;
+BigInteger BigInteger::NextPrime(Executor* executor) const {
+  if ((*this) < 2) {
+    return BigInteger(2);
+  }
+  BigInteger candidate = (*this) + 1;
+  while (candidate < kSmallPrimeLimit) {
+    if (candidate.IsProbablePrime()) {
+      return candidate;
+    }
+    ++candidate;
+  }
+
+  // Multiples of the small primes are sieved out of a window of numbers;
+  // the rest are tested in batches of one number per thread, so the first
+  // prime of the batch is the answer.
+  const std::vector<uint32_t>& primes = SmallPrimes();
+  size_t batch = (executor == nullptr) ? 1 : executor->Concurrency();
+  while (true) {
+    std::vector<uint32_t> remainders = SmallPrimeRemainders(candidate);
+    std::vector<bool> is_composite(kSieveWindow, false);
+    for (size_t i = 0; i < primes.size(); ++i) {
+      for (size_t offset = (primes[i] - remainders[i]) % primes[i];
+           offset < kSieveWindow; offset += primes[i]) {
+        is_composite[offset] = true;
+      }
+    }
+    std::vector<size_t> survivors;
+    for (size_t offset = 0; offset < kSieveWindow; ++offset) {
+      if (!is_composite[offset]) {
+        survivors.push_back(offset);
+      }
+    }
+
+    for (size_t begin = 0; begin < survivors.size(); begin += batch) {
+      size_t count = std::min(batch, survivors.size() - begin);
+      std::vector<char> is_prime(count, 0);
+      ParallelFor(executor, count, [&](size_t i) {
+        is_prime[i] = BailliePsw(candidate + survivors[begin + i]);
+      });
+      for (size_t i = 0; i < count; ++i) {
+        if (is_prime[i]) {
+          return candidate + survivors[begin + i];
+        }
+      }
+    }
+    candidate += kSieveWindow;
+  }
 }
 
-void BigInteger::operator*=(const BigInteger& big_int_rhs) {
-  (*this) = (*this) * big_int_rhs;
+// ROOTS AND LOGARITHMS
+
+namespace {
+
+// BASE^EXPONENT by squaring.
+BigInteger Power(const BigInteger& base, uint64_t exponent) {
+  BigInteger result(int64_t{1});
+  BigInteger square = base;
+  while (true) {
+    if (exponent & 1) {
+      result *= square;
+    }
+    exponent >>= 1;
+    if (exponent == 0) {
+      return result;
+    }
+    square = square * square;
+  }
 }
 
-void BigInteger::operator/=(const BigInteger& big_int_rhs) {
-  if (big_int_rhs == BigInteger(0)) {
-    throw DivisionByZeroError{};
+// The leading 64 bits of |VALUE| != 0: |VALUE| = TOP * 2^SHIFT + a rest
+// below 2^SHIFT, and SHIFT = 0 for numbers below 2^64.
+uint64_t LeadingBits(const BigInteger& value, uint64_t& shift) {
+  uint64_t bits = value.BitLength();
+  shift = (bits > 64) ? bits - 64 : 0;
+  const std::vector<uint32_t>& digits = value.Limbs();
+  size_t index = shift / 32;
+  unsigned __int128 window = 0;
+  for (size_t i = std::min(digits.size(), index + 3); i-- > index;) {
+    window = (window << 32) | digits[i];
+  }
+  return static_cast<uint64_t>(window >> (shift % 32));
+}
+
+// log2(|VALUE|) for VALUE != 0, with a relative error of a few ulps.
+double Log2(const BigInteger& value) {
+  uint64_t shift;
+  uint64_t top = LeadingBits(value, shift);
+  return static_cast<double>(shift) + std::log2(static_cast<double>(top));
+}
+
+// An upper bound of floor(VALUE^(1/K)) for VALUE > 0 and K >= 2 with about
+// 40 correct leading bits.
+BigInteger RootEstimate(const BigInteger& value, uint64_t k) {
+  // log2 of the root is SHIFT / K + log2(TOP) / K; the integral part is
+  // split off first, so the fraction keeps the precision of a double.
+  uint64_t shift;
+  uint64_t top = LeadingBits(value, shift);
+  double fraction = (static_cast<double>(shift % k) +
+                     std::log2(static_cast<double>(top))) / k;
+  uint64_t whole = shift / k + static_cast<uint64_t>(fraction);
+  fraction -= std::floor(fraction);
+  // 2^(WHOLE + FRACTION) < 2^53 * 2^LOW_SHIFT, the low part is zeros.
+  uint64_t low_shift = (whole > 52) ? whole - 52 : 0;
+  double mantissa =
+      std::exp2(static_cast<double>(whole - low_shift) + fraction);
+  return BigInteger(static_cast<uint64_t>(mantissa * (1 + 0x1p-40)) + 2)
+      << low_shift;
+}
+
+// Roots of more bits than this start from the root of the upper digits.
+const uint64_t kRootHalvingBits = 256;
+
+// floor(VALUE^(1/K)) for VALUE > 0 and 2 <= K < VALUE.BitLength().
+BigInteger RootMagnitude(const BigInteger& value, uint64_t k) {
+  uint64_t root_bits = (value.BitLength() + k - 1) / k;
+  BigInteger root;
+  if (root_bits > kRootHalvingBits) {
+    // With r = floor((VALUE / 2^(k s))^(1/k)), r 2^s <= root < (r + 1) 2^s:
+    // half of the bits are right and Newton doubles them.
+    uint64_t half = root_bits / 2;
+    root = (RootMagnitude(value >> (half * k), k) + 1) << half;
+  } else {
+    root = RootEstimate(value, k);
+  }
+  // x -> ((k - 1) x + VALUE / x^(k - 1)) / k decreases from every upper
+  // bound of the root and stops at its floor.
+  int64_t factor = static_cast<int64_t>(k);
+  while (true) {
+    BigInteger next =
+        (root * (factor - 1) + value / Power(root, k - 1)) / factor;
+    if (next >= root) {
+      return root;
+    }
+    root = std::move(next);
   }
-  (*this) = *this / big_int_rhs;
 }
 
-void BigInteger::operator+=(int64_t short_number) {
-  (*this) = (*this) + short_number;
+// BASE^EXPONENT from the squares BASE^(2^i), which every thread keeps for
+// the last base it was asked for.
+BigInteger PowerFromTable(uint64_t base, uint64_t exponent) {
+  thread_local uint64_t table_base = 0;
+  thread_local std::vector<BigInteger> squares;
+  if (table_base != base) {
+    table_base = base;
+    squares.assign(1, BigInteger(base));
+  }
+  BigInteger result(int64_t{1});
+  for (size_t i = 0; exponent != 0; ++i, exponent >>= 1) {
+    if (i == squares.size()) {
+      squares.push_back(squares.back() * squares.back());
+    }
+    if (exponent & 1) {
+      result *= squares[i];
+    }
+  }
+  return result;
 }
 
-void BigInteger::operator-=(int64_t short_number) {
-  (*this) = (*this) - short_number;
+// Primes q whose q - 1 has small prime factors p: p-th powers are p-th
+// power residues modulo q, which only one of p nonzero residues is.
+constexpr std::array<uint32_t, 13> kResiduePrimes = {
+    7, 11, 13, 31, 41, 43, 61, 19, 23, 29, 53, 67, 71};
+
+// BASE^EXPONENT mod MODULUS for a modulus below 2^32.
+uint64_t PowerModDigit(uint64_t base, uint64_t exponent, uint64_t modulus) {
+  uint64_t result = 1 % modulus;
+  base %= modulus;
+  for (; exponent != 0; exponent >>= 1) {
+    if (exponent & 1) {
+      result = result * base % modulus;
+    }
+    base = base * base % modulus;
+  }
+  return result;
 }
 
-void BigInteger::operator*=(int64_t short_number) {
-  (*this) = (*this) * short_number;
+// Primes that IsPowerResidue() takes for one exponent.
+const int kPowerResidueTests = 2;
+
+bool IsSmallPrime(uint64_t n) {
+  for (uint64_t divisor = 2; divisor * divisor <= n; ++divisor) {
+    if (n % divisor == 0) {
+      return false;
+    }
+  }
+  return n >= 2;
 }
 
-void BigInteger::operator/=(int64_t short_number) {
-  if (short_number == 0) {
-    throw DivisionByZeroError{};
+// Takes prime roots of a number > 1 while it has them. The facts that
+// the tests need are computed once for every new value: the residues
+// modulo kResiduePrimes, the power of two and the logarithm.
+class RootTaker {
+ public:
+  explicit RootTaker(BigInteger value) {
+    Reset(std::move(value));
   }
-  (*this) = (*this) / BigInteger(short_number);
+
+  const BigInteger& Value() const {
+    return value_;
+  }
+
+  // Replaces the value by its P-th root if it is a P-th power.
+  bool TakeRoot(uint64_t p) {
+    if (twos_ != 0 && twos_ % p != 0) {
+      return false;
+    }
+    bool has_residues = false;
+    for (size_t i = 0; i < kResiduePrimes.size(); ++i) {
+      uint32_t q = kResiduePrimes[i];
+      if ((q - 1) % p != 0) {
+        continue;
+      }
+      has_residues = true;
+      if (residues_[i] != 0 &&
+          PowerModDigit(residues_[i], (q - 1) / p, q) != 1) {
+        return false;
+      }
+    }
+
+    BigInteger root;
+    if (bits_ <= 32 * p) {
+      // The root is below 2^32, so the logarithm rounds to it, and a wrong
+      // one is seen in the logarithm of its power.
+      uint64_t short_root = std::llround(std::exp2(log2_ / p));
+      double error = p * std::log2(static_cast<double>(short_root)) - log2_;
+      if (short_root < 2 || std::abs(error) > p * 0x1p-36) {
+        return false;
+      }
+      root = BigInteger(short_root);
+    } else {
+      if (!has_residues && !IsPowerResidue(p)) {
+        return false;
+      }
+      root = RootMagnitude(value_, p);
+    }
+    // The lowest digits of the power are compared before the whole power.
+    uint32_t low_digit = static_cast<uint32_t>(
+        PowerModDigit(root.Limbs()[0], p, uint64_t{1} << 32));
+    if (low_digit != value_.Limbs()[0] || Power(root, p) != value_) {
+      return false;
+    }
+    Reset(std::move(root));
+    return true;
+  }
+
+ private:
+  // Whether the value is a P-th power residue modulo the first primes
+  // q = 2 j P + 1; one pass over the digits costs far less than a root.
+  bool IsPowerResidue(uint64_t p) const {
+    const std::vector<uint32_t>& digits = value_.Limbs();
+    int tested = 0;
+    for (uint64_t q = 2 * p + 1;
+         tested < kPowerResidueTests && q <= UINT32_MAX; q += 2 * p) {
+      if (!IsSmallPrime(q)) {
+        continue;
+      }
+      ++tested;
+      uint32_t residue = kernels::RemainderByDigit(
+          digits.data(), digits.size(), static_cast<uint32_t>(q));
+      if (residue != 0 && PowerModDigit(residue, (q - 1) / p, q) != 1) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void Reset(BigInteger value) {
+    value_ = std::move(value);
+    bits_ = value_.BitLength();
+    twos_ = value_.CountTrailingZeros();
+    log2_ = Log2(value_);
+    const std::vector<uint32_t>& digits = value_.Limbs();
+    size_t begin = 0;
+    while (begin < kResiduePrimes.size()) {
+      uint64_t product = 1;
+      size_t end = begin;
+      while (end < kResiduePrimes.size() &&
+             product * kResiduePrimes[end] <= UINT32_MAX) {
+        product *= kResiduePrimes[end++];
+      }
+      uint32_t remainder = kernels::RemainderByDigit(
+          digits.data(), digits.size(), static_cast<uint32_t>(product));
+      for (size_t i = begin; i < end; ++i) {
+        residues_[i] = remainder % kResiduePrimes[i];
+      }
+      begin = end;
+    }
+  }
+
+  BigInteger value_;
+  uint64_t bits_{0};
+  uint64_t twos_{0};
+  double log2_{0};
+  std::array<uint32_t, kResiduePrimes.size()> residues_{};
+};
+
+}  // namespace
+
+BigInteger BigInteger::IRoot(const BigInteger& big_int, uint64_t k) {
+  if (k == 0) {
+    throw std::invalid_argument("Root of degree 0");
+  }
+  if (big_int.sign_ < 0 && k % 2 == 0) {
+    throw std::runtime_error("Even root of a negative number");
+  }
+  if (k == 1 || big_int.sign_ == 0) {
+    return big_int;
+  }
+  // |x| < 2^bits <= 2^k, so the root is 1.
+  if (k >= big_int.BitLength()) {
+    return BigInteger(int64_t{big_int.sign_});
+  }
+  BigInteger root = RootMagnitude(big_int.abs(), k);
+  if (big_int.sign_ < 0) {
+    root.Negate();
+  }
+  return root;
 }
 
-BigInteger BigInteger::operator%(uint32_t short_number) const {
-  int64_t signed_short = short_number;
-  if (signed_short == 0) {
-    throw DivisionByZeroError{};
+uint64_t BigInteger::ILog(const BigInteger& big_int, uint64_t base) {
+  if (big_int.sign_ <= 0) {
+    throw std::invalid_argument("Logarithm of a non-positive number");
   }
-  BigInteger reduce = (*this) - ((*this) / signed_short) * signed_short;
-  if (reduce >= 0) {
-    return reduce;
-  } else {
-    return reduce + signed_short;
+  if (base < 2) {
+    throw std::invalid_argument("Logarithm base below 2");
+  }
+  uint64_t bits = big_int.BitLength();
+  if (std::has_single_bit(base)) {
+    return (bits - 1) / std::countr_zero(base);
+  }
+  uint64_t shift;
+  uint64_t top = LeadingBits(big_int, shift);
+  if (shift == 0) {
+    uint64_t result = 0;
+    for (; top >= base; top /= base) {
+      ++result;
+    }
+    return result;
+  }
+
+  // The estimate is off by far less than the margin, so its floor is the
+  // answer unless it is that close to an integer.
+  double estimate = Log2(big_int) / std::log2(static_cast<double>(base));
+  double margin = (estimate + 1) * 0x1p-40;
+  double whole = std::floor(estimate);
+  if (estimate - whole > margin && whole + 1 - estimate > margin) {
+    return static_cast<uint64_t>(whole);
+  }
+  uint64_t nearest = static_cast<uint64_t>(std::llround(estimate));
+  if (PowerFromTable(base, nearest) <= big_int) {
+    return nearest;
   }
+  return nearest - 1;
 }
 
-// UNARY OPERATIONS
+bool BigInteger::IsPerfectPower(const BigInteger& big_int) {
+  BigInteger root;
+  uint64_t exponent;
+  return IsPerfectPower(big_int, root, exponent);
+}
 
-BigInteger BigInteger::operator-() const {
-  BigInteger result = (*this);
-  result.sign_ = -sign_;
-  return result;
+bool BigInteger::IsPerfectPower(const BigInteger& big_int, BigInteger& root,
+                                uint64_t& exponent) {
+  if (big_int.abs() <= 1) {
+    root = big_int;
+    exponent = (big_int.sign_ < 0) ? 3 : 2;
+    return true;
+  }
+  // x = y^(p q) shows up as a p-th power whose root is a q-th power, so
+  // the roots are taken prime by prime, each prime as long as it goes.
+  // Negative numbers have odd exponents only.
+  RootTaker taker(big_int.abs());
+  uint64_t total = 1;
+  uint64_t p = (big_int.sign_ < 0) ? 3 : 2;
+  while (p < taker.Value().BitLength()) {
+    if (taker.TakeRoot(p)) {
+      total *= p;
+      continue;
+    }
+    do {
+      ++p;
+    } while (!IsSmallPrime(p));
+  }
+  if (total == 1) {
+    return false;
+  }
+  root = taker.Value();
+  if (big_int.sign_ < 0) {
+    root.Negate();
+  }
+  exponent = total;
+  return true;
 }
 
+// UNARY OPERATIONS
+
 BigInteger& BigInteger::operator++() {
   (*this) += 1;
   return *this;
@@ -653,12 +1857,9 @@ BigInteger BigInteger::operator--(int) {
   return (*this) + 1;
 }
 
-}  // namespace big_num_arithmetic
-
 // STREAMS PROCESSING
 
-std::istream& big_num_arithmetic::operator>>(std::istream& input,
-                         big_num_arithmetic::BigInteger& big_int) {
+std::istream& operator>>(std::istream& input, BigInteger& big_int) {
   std::string temp;
   input >> temp;
   auto flag = input.flags();
@@ -669,7 +1870,7 @@ std::istream& big_num_arithmetic::operator>>(std::istream& input,
     base = 16;
   }
 
-  int index = 0;
+  size_t index = 0;
   if (base != 10) {
     if (temp.at(index) == '-') {
       index++;
@@ -682,12 +1883,11 @@ std::istream& big_num_arithmetic::operator>>(std::istream& input,
       temp.erase(index, for_deleting);
     }
   }
-  big_int = big_num_arithmetic::BigInteger::FromString(temp, base);
+  big_int = BigInteger::FromString(temp, base);
   return input;
 }
 
-std::ostream& big_num_arithmetic::operator<<(std::ostream& output,
-                         const big_num_arithmetic::BigInteger& big_int) {
+std::ostream& operator<<(std::ostream& output, const BigInteger& big_int) {
   int base = 10;
   auto flag = output.flags();
   if (flag & std::ios::hex) {
@@ -695,7 +1895,7 @@ std::ostream& big_num_arithmetic::operator<<(std::ostream& output,
   } else if (flag & std::ios::oct) {
     base = 8;
   }
-  big_num_arithmetic::BigInteger temp_value{big_int};
+  BigInteger temp_value{big_int};
   std::string result{};
   if (temp_value.Sign() == -1) {
     result = "-";
@@ -711,3 +1911,5 @@ std::ostream& big_num_arithmetic::operator<<(std::ostream& output,
   result += temp_value.ToString(base);
   return output << result;
 }
+
+}  // namespace big_num_arithmetic
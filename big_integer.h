@@ -1,124 +1,703 @@
 #ifndef BIG_INTEGER_H_
 #define BIG_INTEGER_H_
 
+#include "instrumentation.h"
+#include "limb_kernels.h"
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace big_num_arithmetic {
 
 struct DivisionByZeroError {};
 
+class Executor;
+
 class BigInteger {
  public:
-  static int internal_base;
+  // Digits are stored from the lowest one in base 2^32, so every digit
+  // is a native uint32_t and a product of two digits fits into uint64_t.
+  static constexpr uint64_t internal_base = uint64_t{1} << 32;
 
   // CREATION
-  BigInteger() = default;
-  explicit BigInteger(int64_t);
+  constexpr BigInteger() = default;
+  constexpr explicit BigInteger(int64_t);
+  constexpr explicit BigInteger(uint64_t);
+  constexpr explicit BigInteger(__int128);
+  // Other integer types, so that BigInteger(5) is not ambiguous.
+  template<typename Integer>
+    requires std::is_integral_v<Integer> &&
+             (sizeof(Integer) < sizeof(int64_t) ||
+              std::is_same_v<Integer, long long> ||
+              std::is_same_v<Integer, unsigned long long>)
+  constexpr explicit BigInteger(Integer);
+  // Rounds towards zero; throws std::runtime_error for infinity and NaN.
+  explicit BigInteger(double);
+
+  // Builds a non-negative number from |size| digits, the lowest first.
+  static constexpr BigInteger FromLimbs(const uint32_t*, size_t);
 
   // TO INT64_T CONVERTING
+  // Requires |x| <= INT64_MAX, otherwise throws std::runtime_error.
   explicit operator int64_t() const;
 
+  // NATIVE CONVERSIONS
+  // These read at most four digits. The throwing ones report a value out
+  // of range with std::runtime_error, the Try ones return std::nullopt.
+  bool FitsInt64() const;
+  int64_t ToInt64() const;
+  uint64_t ToUInt64() const;
+  __int128 ToInt128() const;
+  std::optional<int64_t> TryToInt64() const;
+  std::optional<uint64_t> TryToUInt64() const;
+  std::optional<__int128> TryToInt128() const;
+  // Nearest double, ties to even; +-infinity if x is out of its range.
+  double ToDouble() const;
+
   // STRING PROCESSING
   static BigInteger FromString(const std::string&, int);
   std::string ToString(int) const;
 
   // ADDITIONAL FUNCTIONS
-  int Sign() const;
-  void Negate();
-  void Abs();
+  constexpr int Sign() const;
+  // Digits of internal_base, the lowest first; zero has none.
+  constexpr const std::vector<uint32_t>& Limbs() const;
+  constexpr void Negate();
+  constexpr void Abs();
+  // Hash of the sign and the digits, so equal numbers have equal hashes;
+  // std::hash<BigInteger> returns it.
+  constexpr uint64_t Hash() const;
 
   // COMPARING
-  bool operator==(const BigInteger&) const;
-  bool operator<=(const BigInteger&) const;
-  bool operator<(const BigInteger&) const;
-  bool operator>(const BigInteger&) const;
-  bool operator>=(const BigInteger&) const;
-  bool operator!=(const BigInteger&) const;
-
-  bool operator==(int64_t) const;
-  bool operator!=(int64_t) const;
-  bool operator<=(int64_t) const;
-  bool operator<(int64_t) const;
-  bool operator>(int64_t) const;
-  bool operator>=(int64_t) const;
-  friend bool operator==(int64_t, const BigInteger&);
-  friend bool operator!=(int64_t, const BigInteger&);
-  friend bool operator<=(int64_t, const BigInteger&);
-  friend bool operator<(int64_t, const BigInteger&);
-  friend bool operator>(int64_t, const BigInteger&);
-  friend bool operator>=(int64_t, const BigInteger&);
+  // One pass over the digits, without copies; the other comparison
+  // operators, the reversed ones with int64_t on the left included, are
+  // derived from these by the compiler.
+  constexpr bool operator==(const BigInteger&) const;
+  constexpr std::strong_ordering operator<=>(const BigInteger&) const;
+  constexpr bool operator==(int64_t) const;
+  constexpr std::strong_ordering operator<=>(int64_t) const;
+  // Returns -1, 0 or 1 comparing |LHS| and |RHS|.
+  static constexpr int CompareMagnitude(const BigInteger&,
+                                        const BigInteger&);
 
   // UNARY OPERATORS
-  BigInteger operator-() const;
+  constexpr BigInteger operator-() const;
   BigInteger& operator++();
   BigInteger operator++(int);
   BigInteger& operator--();
   BigInteger operator--(int);
 
   // MORE OPERATIONS
-  void operator+=(const BigInteger&);
-  void operator-=(const BigInteger&);
-  void operator*=(const BigInteger&);
+  constexpr void operator+=(const BigInteger&);
+  constexpr void operator-=(const BigInteger&);
+  constexpr void operator*=(const BigInteger&);
   void operator/=(const BigInteger&);
 
-  void operator+=(int64_t);
-  void operator-=(int64_t);
-  void operator*=(int64_t);
+  constexpr void operator+=(int64_t);
+  constexpr void operator-=(int64_t);
+  constexpr void operator*=(int64_t);
   void operator/=(int64_t);
 
   // OPERATIONS
-  BigInteger operator+(const BigInteger&) const;
-  BigInteger operator-(const BigInteger&) const;
-  BigInteger operator*(const BigInteger&) const;
+  constexpr BigInteger operator+(const BigInteger&) const;
+  constexpr BigInteger operator-(const BigInteger&) const;
+  constexpr BigInteger operator*(const BigInteger&) const;
   BigInteger operator/(const BigInteger&) const;
 
-  BigInteger operator+(int64_t) const;
-  BigInteger operator-(int64_t) const;
-  BigInteger operator*(int64_t) const;
+  constexpr BigInteger operator+(int64_t) const;
+  constexpr BigInteger operator-(int64_t) const;
+  constexpr BigInteger operator*(int64_t) const;
   BigInteger operator/(int64_t) const;
   BigInteger operator%(uint32_t) const;
-  friend BigInteger operator+(int64_t, const BigInteger&);
-  friend BigInteger operator-(int64_t, const BigInteger&);
-  friend BigInteger operator*(int64_t, const BigInteger&);
+  friend constexpr BigInteger operator+(int64_t, const BigInteger&);
+  friend constexpr BigInteger operator-(int64_t, const BigInteger&);
+  friend constexpr BigInteger operator*(int64_t, const BigInteger&);
   friend BigInteger operator/(int64_t, const BigInteger&);
+  // NUMERATOR / DIVISOR for a NUMERATOR known to be a multiple of DIVISOR.
+  // Jebelean's exact division works from the lowest digit up and reads
+  // only as many digits of NUMERATOR as the quotient has, so it is cheaper
+  // than operator/. The result is unspecified for other numerators.
+  static BigInteger DivExact(const BigInteger& numerator,
+                             const BigInteger& divisor);
+
+  // BIT OPERATIONS
+  // Negative numbers act as two's complement with infinitely many leading
+  // ones, as int64_t does: ~x == -x - 1, and x >> k rounds towards minus
+  // infinity. Each operation takes O(n) for n-digit operands.
+  BigInteger operator<<(uint64_t) const;
+  BigInteger operator>>(uint64_t) const;
+  BigInteger operator&(const BigInteger&) const;
+  BigInteger operator|(const BigInteger&) const;
+  BigInteger operator^(const BigInteger&) const;
+  BigInteger operator~() const;
+  void operator<<=(uint64_t);
+  void operator>>=(uint64_t);
+  void operator&=(const BigInteger&);
+  void operator|=(const BigInteger&);
+  void operator^=(const BigInteger&);
+
+  // Number of bits of |x|, 0 for zero.
+  uint64_t BitLength() const;
+  // Number of one bits of |x|.
+  uint64_t PopCount() const;
+  // Bit of the two's complement of x, the lowest bit has index 0.
+  bool TestBit(uint64_t) const;
+  // Number of zero bits below the lowest one bit, 0 for zero.
+  uint64_t CountTrailingZeros() const;
 
   // STREAMS PROCESSING
   friend std::istream& operator>>(std::istream&, BigInteger&);
   friend std::ostream& operator<<(std::ostream& os,
                                   const BigInteger& fraction);
 
-  BigInteger abs() const;
-  BigInteger negate();
+  constexpr BigInteger abs() const;
+  constexpr BigInteger negate();
+
+  // REDUCTIONS
+  // Positive and negative numbers of the range are summed apart, in place,
+  // so no term needs an allocation of its own.
+  template<typename Range>
+  static BigInteger Sum(const Range&);
+  // Numbers of the range are multiplied by a balanced tree of products, so
+  // the factors of every product have similar sizes; the products of one
+  // level of the tree run on the executor. The empty product is 1.
+  template<typename Range>
+  static BigInteger Product(const Range&, Executor* = nullptr);
+  static BigInteger Factorial(uint64_t, Executor* = nullptr);
+  // Number of k-element subsets of an n-element set, 0 for k > n.
+  static BigInteger Binomial(uint64_t n, uint64_t k, Executor* = nullptr);
+
+  // NUMBER THEORY
+  // Greatest common divisor of |a| and |b|, 0 for a = b = 0. Lehmer's
+  // algorithm on the leading 63 bits, the half-gcd recursion for numbers
+  // of hundreds of digits and the binary algorithm for the last word.
+  static BigInteger Gcd(const BigInteger&, const BigInteger&);
+  // Returns g = Gcd(a, b) and writes x and y with a x + b y = g. For b != 0
+  // x is the least non-negative one, 0 <= x < |b| / g.
+  static BigInteger ExtendedGcd(const BigInteger& a, const BigInteger& b,
+                                BigInteger& x, BigInteger& y);
+  // x with a x = 1 modulo m, 0 <= x < |m|. Throws std::runtime_error if
+  // Gcd(a, m) != 1.
+  static BigInteger ModInverse(const BigInteger& a, const BigInteger& m);
+
+  // PRIMES
+  // Trial division by the primes below 4096, then the Baillie-PSW test (a
+  // strong Fermat test to base 2 and a strong Lucas test), which has no
+  // known counterexamples. Every extra round adds a Miller-Rabin test to
+  // the next odd prime base, 3, 5, 7, ...; the rounds run on the executor.
+  bool IsProbablePrime(int rounds = 0, Executor* = nullptr) const;
+  // The least probable prime above x. Candidates that survive a sieve by
+  // the small primes are tested on the executor, one per thread.
+  BigInteger NextPrime(Executor* = nullptr) const;
+
+  // ROOTS AND LOGARITHMS
+  // The k-th root rounded towards zero, so floor(x^(1/k)) for x >= 0.
+  // Newton's iteration starts from an estimate by the leading bits; big
+  // roots take the root of the upper half of the digits as the estimate.
+  // Throws std::invalid_argument for k = 0 and std::runtime_error for even
+  // roots of negative numbers.
+  static BigInteger IRoot(const BigInteger& x, uint64_t k);
+  // floor(log_base(x)). Takes the bit length for bases 2^n; for other
+  // bases the leading bits decide unless x is close to a power, which is
+  // then built from the squares of the base kept by every thread for its
+  // last base. Throws std::invalid_argument for x <= 0 or base < 2.
+  static uint64_t ILog(const BigInteger& x, uint64_t base);
+  // Whether x = y^k for integers y and k >= 2. The other overload writes
+  // the least |y| and the greatest k; 0 and 1 are taken as their squares
+  // and -1 as its cube. Prime exponents are tested by residues modulo
+  // small primes and by the leading bits before a root is taken.
+  static bool IsPerfectPower(const BigInteger& x);
+  static bool IsPerfectPower(const BigInteger& x, BigInteger& root,
+                             uint64_t& exponent);
+
+  // RANDOM NUMBERS
+  // The generator must return uniform 64-bit words, as std::mt19937_64
+  // does; each word fills two digits.
+  // Uniform in [0, 2^bits).
+  template<typename Rng>
+  static BigInteger Random(uint64_t bits, Rng&);
+  // Uniform in [0, bound): numbers of the bit length of the bound are
+  // drawn until one is below it, so there is no modulo bias and fewer
+  // than two draws are taken on average. Throws std::invalid_argument if
+  // the bound is not positive.
+  template<typename Rng>
+  static BigInteger RandomBelow(const BigInteger& bound, Rng&);
+
+  // PARALLELISM
+  // Products and quotients of numbers with thousands of digits split their
+  // work over the executor; nullptr, the default, keeps everything on the
+  // calling thread. The executor must outlive its use.
+  static void SetExecutor(Executor*);
 
  private:
+  friend class BigIntegerView;
+  friend class ModContext;
+  friend void AppendBinary(const BigInteger&, std::string&);
+  friend size_t BinarySize(const BigInteger&);
+
   int sign_{0};
-  std::vector<int> digits_;
+  // Zero has no digits at all, any other number has a non-zero
+  // highest digit. CleanLeadZeroes() restores both invariants.
+  std::vector<uint32_t> digits_;
 
-  void CleanLeadZeroes();
-  void ReverseDigits();
+  constexpr void CleanLeadZeroes();
   static char IntToChar(int);
   static int CharToInt(char);
-  static int NextDigit(std::vector<int>&, int, int);
-  static int GetDigit(const std::vector<int>&, long long);
-  static BigInteger PowerOfTen(long long, const BigInteger&);
+  static uint32_t NextDigit(std::vector<uint32_t>&, uint64_t, uint64_t);
+
+  // Writes BITS random bits to result, reusing its digits.
+  template<typename Rng>
+  static void FillRandom(uint64_t bits, Rng&, BigInteger& result);
 
-  // This function divides big_integer on short_number,
-  // where short_number < internal_base.
-  static int GetShortDivision(const BigInteger&, const BigInteger&);
+  // |*this| += |value|, in place; zero takes the sign of the value.
+  void AddMagnitude(const BigInteger&);
+  static BigInteger ProductTree(std::vector<BigInteger>, Executor*);
 
   // Next function return sum of two big integers with the same sign.
   // I.e. it will return -(|LHS| + |RHS|), if LHS <= 0, RHS <= 0 and
   // (|LHS| + |RHS|), if LHS >= 0, RHS >= 0 respectively.
-  static BigInteger UnsignedSum(const BigInteger&, const BigInteger&);
+  static constexpr BigInteger UnsignedSum(const BigInteger&,
+                                          const BigInteger&);
 
   // This one is has the same idea. As in previous one, I use it
   // only for |LHS| >= |RHS|, where LHS * RHS >= 0.
   // The function returns (|LHS| - |RHS|), if LHS >= 0, RHS >= 0 and
   // -(|LHS| - |RHS|), if LHS <= 0, RHS <= 0 respectively.
-  static BigInteger UnsignedSubtract(const BigInteger&, const BigInteger&);
+  static constexpr BigInteger UnsignedSubtract(const BigInteger&,
+                                               const BigInteger&);
 };
 
+// Everything below is defined in the header, because constexpr functions
+// must be visible at the point of use. Only the transient allocations of
+// std::vector are used, so the results can be compared, added and
+// multiplied during constant evaluation (C++20).
+
+// CREATION
+
+constexpr BigInteger::BigInteger(int64_t short_number)
+    : BigInteger(static_cast<__int128>(short_number)) {}
+
+constexpr BigInteger::BigInteger(uint64_t short_number)
+    : BigInteger(static_cast<__int128>(short_number)) {}
+
+constexpr BigInteger::BigInteger(__int128 short_number) {
+  if (short_number == 0) {
+    return;
+  }
+  sign_ = (short_number < 0) ? -1 : 1;
+  // Negating in unsigned arithmetic keeps the minimum representable.
+  unsigned __int128 new_value = (short_number < 0)
+      ? 0 - static_cast<unsigned __int128>(short_number)
+      : static_cast<unsigned __int128>(short_number);
+  while (new_value) {
+    digits_.push_back(static_cast<uint32_t>(new_value % internal_base));
+    new_value /= internal_base;
+  }
+}
+
+template<typename Integer>
+  requires std::is_integral_v<Integer> &&
+           (sizeof(Integer) < sizeof(int64_t) ||
+            std::is_same_v<Integer, long long> ||
+            std::is_same_v<Integer, unsigned long long>)
+constexpr BigInteger::BigInteger(Integer short_number)
+    : BigInteger(static_cast<__int128>(short_number)) {}
+
+constexpr BigInteger BigInteger::FromLimbs(const uint32_t* limbs,
+                                           size_t size) {
+  BigInteger number;
+  number.sign_ = 1;
+  number.digits_.assign(limbs, limbs + size);
+  number.CleanLeadZeroes();
+  return number;
+}
+
+// ADDITIONAL FUNCTIONS
+
+constexpr int BigInteger::Sign() const {
+  return sign_;
+}
+
+constexpr const std::vector<uint32_t>& BigInteger::Limbs() const {
+  return digits_;
+}
+
+constexpr void BigInteger::Negate() {
+  sign_ = -sign_;
+}
+
+constexpr BigInteger BigInteger::negate() {
+  sign_ = -sign_;
+  return *this;
+}
+
+constexpr BigInteger BigInteger::abs() const {
+  BigInteger value_abs;
+  value_abs.sign_ = (sign_ < 0) ? 1 : sign_;
+  value_abs.digits_ = digits_;
+  return value_abs;
+}
+
+constexpr uint64_t BigInteger::Hash() const {
+  // Zero has no digits and sign 0, so it has a single hash.
+  return kernels::Hash(digits_.data(), digits_.size(),
+                       static_cast<uint64_t>(sign_ + 1));
+}
+
+constexpr void BigInteger::Abs() {
+  sign_ = (sign_ < 0) ? 1 : sign_;
+}
+
+constexpr void BigInteger::CleanLeadZeroes() {
+  while (!digits_.empty() && digits_.back() == 0) {
+    digits_.pop_back();
+  }
+  if (digits_.empty()) {
+    sign_ = 0;
+  }
+}
+
+// COMPARING TWO BIG INTEGERS
+
+constexpr int BigInteger::CompareMagnitude(const BigInteger& big_int_lhs,
+                                           const BigInteger& big_int_rhs) {
+  return kernels::Compare(big_int_lhs.digits_.data(),
+                          big_int_lhs.digits_.size(),
+                          big_int_rhs.digits_.data(),
+                          big_int_rhs.digits_.size());
+}
+
+constexpr bool BigInteger::operator==(const BigInteger& big_int_rhs) const {
+  return sign_ == big_int_rhs.sign_ && digits_ == big_int_rhs.digits_;
+}
+
+constexpr std::strong_ordering BigInteger::operator<=>(
+    const BigInteger& big_int_rhs) const {
+  if (sign_ != big_int_rhs.sign_) {
+    return sign_ <=> big_int_rhs.sign_;
+  }
+  // Equal signs, so the magnitudes decide, in reverse for negatives.
+  int magnitude = CompareMagnitude(*this, big_int_rhs);
+  return ((sign_ < 0) ? -magnitude : magnitude) <=> 0;
+}
+
+// COMPARING BIG INTEGER AND SHORT NUMBER
+
+constexpr bool BigInteger::operator==(int64_t short_number) const {
+  return ((*this) <=> short_number) == 0;
+}
+
+constexpr std::strong_ordering BigInteger::operator<=>(
+    int64_t short_number) const {
+  int short_sign = (short_number > 0) - (short_number < 0);
+  if (sign_ != short_sign) {
+    return sign_ <=> short_sign;
+  }
+  // Negating in unsigned arithmetic keeps INT64_MIN representable.
+  uint64_t short_magnitude = (short_number < 0)
+      ? 0 - static_cast<uint64_t>(short_number)
+      : static_cast<uint64_t>(short_number);
+  std::strong_ordering magnitude = std::strong_ordering::greater;
+  if (digits_.size() <= 2) {
+    uint64_t value = 0;
+    for (size_t i = digits_.size(); i-- > 0;) {
+      value = (value << 32) | digits_[i];
+    }
+    magnitude = value <=> short_magnitude;
+  }
+  return (sign_ < 0) ? 0 <=> magnitude : magnitude;
+}
+
+// BINARY OPERATIONS
+
+constexpr BigInteger BigInteger::UnsignedSum(const BigInteger& big_int_lhs,
+                                             const BigInteger& big_int_rhs) {
+  const BigInteger& longer =
+      (big_int_lhs.digits_.size() >= big_int_rhs.digits_.size())
+      ? big_int_lhs : big_int_rhs;
+  const BigInteger& shorter =
+      (&longer == &big_int_lhs) ? big_int_rhs : big_int_lhs;
+  BigInteger sum;
+  sum.digits_.resize(longer.digits_.size() + 1);
+  sum.digits_.back() = kernels::Add(
+      longer.digits_.data(), longer.digits_.size(),
+      shorter.digits_.data(), shorter.digits_.size(), sum.digits_.data());
+  if (big_int_lhs.sign_ == 0) {
+    sum.sign_ = big_int_rhs.sign_;
+  } else {
+    sum.sign_ = big_int_lhs.sign_;
+  }
+  sum.CleanLeadZeroes();
+  return sum;
+}
+
+constexpr BigInteger BigInteger::UnsignedSubtract(
+    const BigInteger& big_int_lhs, const BigInteger& big_int_rhs) {
+  BigInteger subtract;
+  subtract.digits_.resize(big_int_lhs.digits_.size());
+  kernels::Subtract(big_int_lhs.digits_.data(), big_int_lhs.digits_.size(),
+                    big_int_rhs.digits_.data(), big_int_rhs.digits_.size(),
+                    subtract.digits_.data());
+  subtract.sign_ = big_int_lhs.sign_;
+  subtract.CleanLeadZeroes();
+  return subtract;
+}
+
+constexpr BigInteger BigInteger::operator+(
+    const BigInteger& big_int_rhs) const {
+  if (sign_ == big_int_rhs.sign_) {
+    return UnsignedSum(*this, big_int_rhs);
+  } else if (CompareMagnitude(*this, big_int_rhs) >= 0) {
+    return UnsignedSubtract(*this, big_int_rhs);
+  }
+  return UnsignedSubtract(big_int_rhs, *this);
+}
+
+constexpr BigInteger BigInteger::operator-(
+    const BigInteger& big_int_rhs) const {
+  if (sign_ == 0) {
+    BigInteger result = big_int_rhs;
+    return result.negate();
+  }
+  if (big_int_rhs.sign_ == 0) {
+    return (*this);
+  }
+  if (sign_ != big_int_rhs.sign_) {
+    return UnsignedSum(*this, big_int_rhs);
+  }
+  if (CompareMagnitude(*this, big_int_rhs) >= 0) {
+    return UnsignedSubtract(*this, big_int_rhs);
+  }
+  return UnsignedSubtract(big_int_rhs, *this).negate();
+}
+
+constexpr BigInteger BigInteger::operator*(
+    const BigInteger& big_int_rhs) const {
+  size_t first_size = big_int_rhs.digits_.size();
+  size_t second_size = digits_.size();
+
+  BigInteger product;
+  if (first_size == 0 || second_size == 0) {
+    return product;
+  }
+  BIG_INTEGER_COUNT_MULTIPLY(second_size, first_size);
+  product.sign_ = sign_ * big_int_rhs.sign_;
+  product.digits_.resize(first_size + second_size);
+  kernels::Multiply(digits_.data(), second_size, big_int_rhs.digits_.data(),
+                    first_size, product.digits_.data());
+  product.CleanLeadZeroes();
+  return product;
+}
+
+// OPERATIONS WITH SHORT NUMBERS
+
+constexpr BigInteger operator+(int64_t short_number,
+                               const BigInteger& big_int) {
+  return BigInteger(short_number) + big_int;
+}
+
+constexpr BigInteger operator-(int64_t short_number,
+                               const BigInteger& big_int) {
+  return BigInteger(short_number) - big_int;
+}
+
+constexpr BigInteger operator*(int64_t short_number,
+                               const BigInteger& big_int) {
+  return BigInteger(short_number) * big_int;
+}
+
+constexpr BigInteger BigInteger::operator+(int64_t short_number) const {
+  return (*this) + BigInteger(short_number);
+}
+
+constexpr BigInteger BigInteger::operator-(int64_t short_number) const {
+  return (*this) - BigInteger(short_number);
+}
+
+constexpr BigInteger BigInteger::operator*(int64_t short_number) const {
+  return (*this) * BigInteger(short_number);
+}
+
+constexpr void BigInteger::operator+=(const BigInteger& big_int_rhs) {
+  (*this) = (*this) + big_int_rhs;
+}
+
+constexpr void BigInteger::operator-=(const BigInteger& big_int_rhs) {
+  (*this) = (*this) - big_int_rhs;
+}
+
+constexpr void BigInteger::operator*=(const BigInteger& big_int_rhs) {
+  (*this) = (*this) * big_int_rhs;
+}
+
+constexpr void BigInteger::operator+=(int64_t short_number) {
+  (*this) = (*this) + short_number;
+}
+
+constexpr void BigInteger::operator-=(int64_t short_number) {
+  (*this) = (*this) - short_number;
+}
+
+constexpr void BigInteger::operator*=(int64_t short_number) {
+  (*this) = (*this) * short_number;
+}
+
+// UNARY OPERATIONS
+
+constexpr BigInteger BigInteger::operator-() const {
+  BigInteger result = (*this);
+  result.sign_ = -sign_;
+  return result;
+}
+
+// REDUCTIONS
+
+template<typename Range>
+BigInteger BigInteger::Sum(const Range& range) {
+  BigInteger positive;
+  BigInteger negative;
+  for (const BigInteger& value : range) {
+    if (value.sign_ > 0) {
+      positive.AddMagnitude(value);
+    } else if (value.sign_ < 0) {
+      negative.AddMagnitude(value);
+    }
+  }
+  return positive + negative;
+}
+
+template<typename Range>
+BigInteger BigInteger::Product(const Range& range, Executor* executor) {
+  std::vector<BigInteger> factors;
+  for (const BigInteger& value : range) {
+    factors.push_back(value);
+  }
+  return ProductTree(std::move(factors), executor);
+}
+
+// RANDOM NUMBERS
+
+template<typename Rng>
+void BigInteger::FillRandom(uint64_t bits, Rng& rng, BigInteger& result) {
+  static_assert(std::uniform_random_bit_generator<Rng> &&
+                Rng::min() == 0 && Rng::max() == UINT64_MAX,
+                "The generator must return uniform 64-bit words");
+  size_t size = (bits + 31) / 32;
+  result.digits_.resize(size);
+  for (size_t i = 0; i < size; i += 2) {
+    uint64_t word = rng();
+    result.digits_[i] = static_cast<uint32_t>(word);
+    if (i + 1 < size) {
+      result.digits_[i + 1] = static_cast<uint32_t>(word >> 32);
+    }
+  }
+  if (bits % 32 != 0) {
+    result.digits_.back() &= (uint32_t{1} << (bits % 32)) - 1;
+  }
+  result.sign_ = 1;
+  result.CleanLeadZeroes();
+}
+
+template<typename Rng>
+BigInteger BigInteger::Random(uint64_t bits, Rng& rng) {
+  BigInteger result;
+  FillRandom(bits, rng, result);
+  return result;
+}
+
+template<typename Rng>
+BigInteger BigInteger::RandomBelow(const BigInteger& bound, Rng& rng) {
+  if (bound.sign_ <= 0) {
+    throw std::invalid_argument("Non-positive bound");
+  }
+  uint64_t bits = bound.BitLength();
+  BigInteger result;
+  do {
+    FillRandom(bits, rng, result);
+  } while (result >= bound);
+  return result;
+}
+
+// COMPILE-TIME LITERALS
+
+namespace literals {
+
+// Parses the characters of an integer literal into digits of
+// BigInteger::internal_base, the lowest one first. Prefixes 0x, 0b and 0
+// select hexadecimal, binary and octal notation, as for built-in literals.
+template<char... Chars>
+constexpr auto ParseLiteral() {
+  constexpr char kChars[] = {Chars...};
+  constexpr size_t kSize = sizeof...(Chars);
+  // No character carries more than 4 bits, so the array never overflows.
+  std::array<uint32_t, kSize * 4 / 32 + 1> limbs{};
+
+  uint64_t base = 10;
+  size_t start = 0;
+  if (kSize > 1 && kChars[0] == '0') {
+    if (kChars[1] == 'x' || kChars[1] == 'X') {
+      base = 16;
+      start = 2;
+    } else if (kChars[1] == 'b' || kChars[1] == 'B') {
+      base = 2;
+      start = 2;
+    } else {
+      base = 8;
+      start = 1;
+    }
+  }
+  for (size_t i = start; i < kSize; ++i) {
+    char sign = kChars[i];
+    if (sign == '\'') {
+      continue;
+    }
+    uint64_t digit = base;
+    if (sign >= '0' && sign <= '9') {
+      digit = sign - '0';
+    } else if (sign >= 'a' && sign <= 'f') {
+      digit = sign - 'a' + 10;
+    } else if (sign >= 'A' && sign <= 'F') {
+      digit = sign - 'A' + 10;
+    }
+    if (digit >= base) {
+      throw std::logic_error("Invalid BigInteger literal");
+    }
+    uint64_t carry = digit;
+    for (uint32_t& limb : limbs) {
+      carry += limb * base;
+      limb = static_cast<uint32_t>(carry % BigInteger::internal_base);
+      carry /= BigInteger::internal_base;
+    }
+  }
+  return limbs;
+}
+
+// 123456789012345678901234567890_bi is parsed by the compiler, at run time
+// only the ready digits are copied into the result.
+template<char... Chars>
+constexpr BigInteger operator""_bi() {
+  constexpr auto kLimbs = ParseLiteral<Chars...>();
+  return BigInteger::FromLimbs(kLimbs.data(), kLimbs.size());
+}
+
+}  // namespace literals
+
 }  // namespace big_num_arithmetic
 
+template<>
+struct std::hash<big_num_arithmetic::BigInteger> {
+  size_t operator()(const big_num_arithmetic::BigInteger& big_int) const {
+    return static_cast<size_t>(big_int.Hash());
+  }
+};
+
 #endif  // BIG_INTEGER_H_
@@ -0,0 +1,112 @@
+#include "big_integer_accumulator.h"
+
+namespace big_num_arithmetic {
+
+namespace {
+
+// A slot holds at most 2^32 - 1 after the carries are propagated, and
+// every term adds at most 2^32 - 1, so 2^32 - 1 terms fit into 64 bits.
+const uint64_t kMaxPendingTerms = UINT32_MAX;
+
+// Non-negative number with the digits of SLOTS, whose carries are
+// already propagated.
+BigInteger FromSlots(const std::vector<uint64_t>& slots) {
+  std::vector<uint32_t> digits(slots.begin(), slots.end());
+  return BigInteger::FromLimbs(digits.data(), digits.size());
+}
+
+}  // namespace
+
+void BigIntegerAccumulator::Bank::Add(const uint32_t* digits, size_t size) {
+  if (terms == kMaxPendingTerms) {
+    PropagateCarries();
+  }
+  if (slots.size() < size) {
+    slots.resize(size, 0);
+  }
+  // Independent additions, which the compiler may vectorize.
+  for (size_t i = 0; i < size; ++i) {
+    slots[i] += digits[i];
+  }
+  ++terms;
+}
+
+void BigIntegerAccumulator::Bank::PropagateCarries() {
+  uint64_t carry = 0;
+  for (uint64_t& slot : slots) {
+    // The sum fits: slot <= 2^64 - 2^32 and carry < 2^32.
+    uint64_t sum = slot + carry;
+    slot = sum & UINT32_MAX;
+    carry = sum >> 32;
+  }
+  while (carry != 0) {
+    slots.push_back(carry & UINT32_MAX);
+    carry >>= 32;
+  }
+  terms = 0;
+}
+
+void BigIntegerAccumulator::Add(const BigInteger& big_int) {
+  const std::vector<uint32_t>& digits = big_int.Limbs();
+  if (big_int.Sign() > 0) {
+    positive_.Add(digits.data(), digits.size());
+  } else if (big_int.Sign() < 0) {
+    negative_.Add(digits.data(), digits.size());
+  }
+}
+
+void BigIntegerAccumulator::Add(int64_t short_number) {
+  // Negating in unsigned arithmetic keeps INT64_MIN representable.
+  uint64_t magnitude = (short_number < 0)
+      ? 0 - static_cast<uint64_t>(short_number)
+      : static_cast<uint64_t>(short_number);
+  uint32_t digits[2] = {static_cast<uint32_t>(magnitude),
+                        static_cast<uint32_t>(magnitude >> 32)};
+  if (short_number > 0) {
+    positive_.Add(digits, 2);
+  } else if (short_number < 0) {
+    negative_.Add(digits, 2);
+  }
+}
+
+void BigIntegerAccumulator::Subtract(const BigInteger& big_int) {
+  const std::vector<uint32_t>& digits = big_int.Limbs();
+  if (big_int.Sign() > 0) {
+    negative_.Add(digits.data(), digits.size());
+  } else if (big_int.Sign() < 0) {
+    positive_.Add(digits.data(), digits.size());
+  }
+}
+
+void BigIntegerAccumulator::Subtract(int64_t short_number) {
+  if (short_number == INT64_MIN) {
+    // -INT64_MIN is not an int64_t.
+    Add(INT64_MAX);
+    Add(int64_t{1});
+    return;
+  }
+  Add(-short_number);
+}
+
+void BigIntegerAccumulator::operator+=(const BigInteger& big_int) {
+  Add(big_int);
+}
+
+void BigIntegerAccumulator::operator-=(const BigInteger& big_int) {
+  Subtract(big_int);
+}
+
+BigInteger BigIntegerAccumulator::Result() const {
+  Bank positive = positive_;
+  Bank negative = negative_;
+  positive.PropagateCarries();
+  negative.PropagateCarries();
+  return FromSlots(positive.slots) - FromSlots(negative.slots);
+}
+
+void BigIntegerAccumulator::Clear() {
+  positive_ = Bank();
+  negative_ = Bank();
+}
+
+}  // namespace big_num_arithmetic
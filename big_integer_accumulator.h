@@ -0,0 +1,47 @@
+#ifndef BIG_INTEGER_ACCUMULATOR_H_
+#define BIG_INTEGER_ACCUMULATOR_H_
+
+#include "big_integer.h"
+#include <vector>
+
+namespace big_num_arithmetic {
+
+// Sum of many numbers with deferred carries. Every digit of a term is
+// added to a 64-bit slot of its position, so adding a term is one loop
+// without a carry chain and without allocations once the slots are long
+// enough. Positive and negative terms go to separate banks, and carries
+// are propagated only by Result() (and once per 2^32 terms of a bank, so
+// that the slots never overflow).
+class BigIntegerAccumulator {
+ public:
+  BigIntegerAccumulator() = default;
+
+  void Add(const BigInteger&);
+  void Add(int64_t);
+  void Subtract(const BigInteger&);
+  void Subtract(int64_t);
+  void operator+=(const BigInteger&);
+  void operator-=(const BigInteger&);
+
+  // The sum of all the terms added so far; the accumulator is unchanged.
+  BigInteger Result() const;
+  void Clear();
+
+ private:
+  struct Bank {
+    std::vector<uint64_t> slots;
+    // Terms added since the last propagation of carries.
+    uint64_t terms{0};
+
+    void Add(const uint32_t* digits, size_t size);
+    // Leaves a digit in the lower half of every slot.
+    void PropagateCarries();
+  };
+
+  Bank positive_;
+  Bank negative_;
+};
+
+}  // namespace big_num_arithmetic
+
+#endif  // BIG_INTEGER_ACCUMULATOR_H_
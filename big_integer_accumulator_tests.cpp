@@ -0,0 +1,61 @@
+#include "big_integer_accumulator.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace big_num_arithmetic {
+
+TEST(Test_42, AccumulatorSums) {
+  {
+    BigIntegerAccumulator accumulator;
+    EXPECT_TRUE(accumulator.Result() == 0);
+    accumulator.Add(INT64_MIN);
+    accumulator.Subtract(INT64_MIN);
+    accumulator.Add(int64_t{0});
+    accumulator += BigInteger(0);
+    EXPECT_TRUE(accumulator.Result() == 0);
+    accumulator.Subtract(INT64_MIN);
+    EXPECT_TRUE(accumulator.Result() == BigInteger(INT64_MAX) + 1);
+    accumulator.Clear();
+    accumulator -= BigInteger(5);
+    EXPECT_TRUE(accumulator.Result() == -5);
+  }
+  {
+    // Every digit of the terms is 2^32 - 1, so the slots carry the most.
+    BigInteger all_ones = (BigInteger(1) << 320) - 1;
+    BigIntegerAccumulator accumulator;
+    BigInteger expected;
+    for (int i = 0; i < 1000; ++i) {
+      accumulator += all_ones;
+      expected += all_ones;
+    }
+    EXPECT_TRUE(accumulator.Result() == expected);
+    accumulator.Add(int64_t{-1});
+    EXPECT_TRUE(accumulator.Result() == expected - 1);
+    // Result() leaves the sum as it is.
+    EXPECT_TRUE(accumulator.Result() == expected - 1);
+  }
+  {
+    std::mt19937_64 rng(42);
+    BigIntegerAccumulator accumulator;
+    BigInteger expected;
+    for (int i = 0; i < 2000; ++i) {
+      BigInteger term = BigInteger::Random(rng() % 700, rng);
+      if (rng() % 3 == 0) {
+        term = -term;
+      }
+      if (rng() % 2 == 0) {
+        accumulator.Add(term);
+        expected += term;
+      } else {
+        accumulator.Subtract(term);
+        expected -= term;
+      }
+      int64_t short_number = static_cast<int64_t>(rng());
+      accumulator.Add(short_number);
+      expected += short_number;
+    }
+    EXPECT_TRUE(accumulator.Result() == expected);
+  }
+}
+
+}  // namespace big_num_arithmetic
@@ -0,0 +1,270 @@
+#include "big_integer_array.h"
+#include "limb_kernels.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace big_num_arithmetic {
+
+BigIntegerArray::BigIntegerArray(const std::vector<BigInteger>& values) {
+  size_t limbs = 0;
+  for (const BigInteger& value : values) {
+    limbs += value.Limbs().size();
+  }
+  Reserve(values.size(), limbs);
+  for (const BigInteger& value : values) {
+    PushBack(value);
+  }
+}
+
+void BigIntegerArray::Reserve(size_t size, size_t limbs) {
+  limbs_.reserve(limbs);
+  offsets_.reserve(size + 1);
+  signs_.reserve(size);
+}
+
+void BigIntegerArray::PushBack(const BigInteger& value) {
+  AppendDigits(value.Sign(), value.Limbs().data(), value.Limbs().size());
+}
+
+size_t BigIntegerArray::Size() const {
+  return signs_.size();
+}
+
+size_t BigIntegerArray::LimbCount() const {
+  return limbs_.size();
+}
+
+int BigIntegerArray::Sign(size_t index) const {
+  return signs_.at(index);
+}
+
+BigInteger BigIntegerArray::At(size_t index) const {
+  if (index >= Size()) {
+    throw std::out_of_range("BigIntegerArray index out of range");
+  }
+  BigInteger value = BigInteger::FromLimbs(Data(index), Length(index));
+  if (signs_[index] < 0) {
+    value.Negate();
+  }
+  return value;
+}
+
+std::vector<BigInteger> BigIntegerArray::ToVector() const {
+  std::vector<BigInteger> values;
+  values.reserve(Size());
+  for (size_t i = 0; i < Size(); ++i) {
+    values.push_back(At(i));
+  }
+  return values;
+}
+
+// HELP-FUNCTIONS
+
+const uint32_t* BigIntegerArray::Data(size_t index) const {
+  return limbs_.data() + offsets_[index];
+}
+
+size_t BigIntegerArray::Length(size_t index) const {
+  return offsets_[index + 1] - offsets_[index];
+}
+
+void BigIntegerArray::AppendDigits(int sign, const uint32_t* digits,
+                                   size_t size) {
+  limbs_.insert(limbs_.end(), digits, digits + size);
+  offsets_.push_back(limbs_.size());
+  signs_.push_back((size == 0) ? 0 : sign);
+}
+
+void BigIntegerArray::AppendSum(int lhs_sign, const uint32_t* lhs,
+                                size_t lhs_size, int rhs_sign,
+                                const uint32_t* rhs, size_t rhs_size) {
+  // Digits of the result are computed right in the end of the arena, so
+  // the arguments must not point into it.
+  size_t begin = limbs_.size();
+  int order = kernels::Compare(lhs, lhs_size, rhs, rhs_size);
+  if (order < 0) {
+    std::swap(lhs_sign, rhs_sign);
+    std::swap(lhs, rhs);
+    std::swap(lhs_size, rhs_size);
+  }
+  int sign = (lhs_sign == 0) ? rhs_sign : lhs_sign;
+  if (lhs_sign == rhs_sign || rhs_sign == 0) {
+    limbs_.resize(begin + lhs_size + 1);
+    limbs_.back() = kernels::Add(lhs, lhs_size, rhs, rhs_size,
+                                 limbs_.data() + begin);
+  } else {
+    limbs_.resize(begin + lhs_size);
+    kernels::Subtract(lhs, lhs_size, rhs, rhs_size, limbs_.data() + begin);
+  }
+  limbs_.resize(begin + kernels::Normalize(limbs_.data() + begin,
+                                           limbs_.size() - begin));
+  offsets_.push_back(limbs_.size());
+  signs_.push_back((limbs_.size() == begin) ? 0 : sign);
+}
+
+void BigIntegerArray::AppendProduct(int lhs_sign, const uint32_t* lhs,
+                                    size_t lhs_size, int rhs_sign,
+                                    const uint32_t* rhs, size_t rhs_size) {
+  size_t begin = limbs_.size();
+  if (lhs_size != 0 && rhs_size != 0) {
+    limbs_.resize(begin + lhs_size + rhs_size);
+    kernels::Multiply(lhs, lhs_size, rhs, rhs_size, limbs_.data() + begin);
+    limbs_.resize(begin + kernels::Normalize(limbs_.data() + begin,
+                                             lhs_size + rhs_size));
+  }
+  offsets_.push_back(limbs_.size());
+  signs_.push_back((limbs_.size() == begin) ? 0 : lhs_sign * rhs_sign);
+}
+
+// ELEMENT-WISE OPERATIONS
+
+BigIntegerArray BigIntegerArray::operator+(
+    const BigIntegerArray& rhs) const {
+  if (Size() != rhs.Size()) {
+    throw std::invalid_argument("Arrays of different sizes");
+  }
+  BigIntegerArray result;
+  result.Reserve(Size(), std::max(LimbCount(), rhs.LimbCount()) + Size());
+  for (size_t i = 0; i < Size(); ++i) {
+    result.AppendSum(signs_[i], Data(i), Length(i),
+                     rhs.signs_[i], rhs.Data(i), rhs.Length(i));
+  }
+  return result;
+}
+
+BigIntegerArray BigIntegerArray::operator-(
+    const BigIntegerArray& rhs) const {
+  if (Size() != rhs.Size()) {
+    throw std::invalid_argument("Arrays of different sizes");
+  }
+  BigIntegerArray result;
+  result.Reserve(Size(), std::max(LimbCount(), rhs.LimbCount()) + Size());
+  for (size_t i = 0; i < Size(); ++i) {
+    result.AppendSum(signs_[i], Data(i), Length(i),
+                     -rhs.signs_[i], rhs.Data(i), rhs.Length(i));
+  }
+  return result;
+}
+
+BigIntegerArray BigIntegerArray::operator*(
+    const BigIntegerArray& rhs) const {
+  if (Size() != rhs.Size()) {
+    throw std::invalid_argument("Arrays of different sizes");
+  }
+  BigIntegerArray result;
+  result.Reserve(Size(), LimbCount() + rhs.LimbCount());
+  for (size_t i = 0; i < Size(); ++i) {
+    result.AppendProduct(signs_[i], Data(i), Length(i),
+                         rhs.signs_[i], rhs.Data(i), rhs.Length(i));
+  }
+  return result;
+}
+
+BigIntegerArray BigIntegerArray::operator+(const BigInteger& rhs) const {
+  const std::vector<uint32_t>& digits = rhs.Limbs();
+  BigIntegerArray result;
+  result.Reserve(Size(), LimbCount() + Size() * (digits.size() + 1));
+  for (size_t i = 0; i < Size(); ++i) {
+    result.AppendSum(signs_[i], Data(i), Length(i),
+                     rhs.Sign(), digits.data(), digits.size());
+  }
+  return result;
+}
+
+BigIntegerArray BigIntegerArray::operator-(const BigInteger& rhs) const {
+  const std::vector<uint32_t>& digits = rhs.Limbs();
+  BigIntegerArray result;
+  result.Reserve(Size(), LimbCount() + Size() * (digits.size() + 1));
+  for (size_t i = 0; i < Size(); ++i) {
+    result.AppendSum(signs_[i], Data(i), Length(i),
+                     -rhs.Sign(), digits.data(), digits.size());
+  }
+  return result;
+}
+
+BigIntegerArray BigIntegerArray::operator*(const BigInteger& rhs) const {
+  const std::vector<uint32_t>& digits = rhs.Limbs();
+  BigIntegerArray result;
+  result.Reserve(Size(), LimbCount() + Size() * digits.size());
+  for (size_t i = 0; i < Size(); ++i) {
+    result.AppendProduct(signs_[i], Data(i), Length(i),
+                         rhs.Sign(), digits.data(), digits.size());
+  }
+  return result;
+}
+
+// REDUCTIONS
+
+BigInteger BigIntegerArray::Sum() const {
+  // Positive and negative elements are summed apart, in place, so that
+  // every step is a single carry chain without any allocation.
+  std::vector<uint32_t> sums[2];
+  for (size_t i = 0; i < Size(); ++i) {
+    if (signs_[i] == 0) {
+      continue;
+    }
+    std::vector<uint32_t>& sum = sums[(signs_[i] > 0) ? 0 : 1];
+    if (sum.size() < Length(i)) {
+      sum.resize(Length(i), 0);
+    }
+    uint32_t carry = kernels::Add(sum.data(), sum.size(), Data(i),
+                                  Length(i), sum.data());
+    if (carry != 0) {
+      sum.push_back(carry);
+    }
+  }
+  BigInteger negative = BigInteger::FromLimbs(sums[1].data(), sums[1].size());
+  negative.Negate();
+  return BigInteger::FromLimbs(sums[0].data(), sums[0].size()) + negative;
+}
+
+BigIntegerArray BigIntegerArray::PairwiseProducts() const {
+  BigIntegerArray level;
+  level.Reserve((Size() + 1) / 2, LimbCount());
+  for (size_t i = 0; i + 1 < Size(); i += 2) {
+    level.AppendProduct(signs_[i], Data(i), Length(i),
+                        signs_[i + 1], Data(i + 1), Length(i + 1));
+  }
+  if (Size() % 2 == 1) {
+    level.AppendDigits(signs_.back(), Data(Size() - 1), Length(Size() - 1));
+  }
+  return level;
+}
+
+BigInteger BigIntegerArray::Product() const {
+  if (Size() == 0) {
+    return BigInteger(1);
+  }
+  if (Size() == 1) {
+    return At(0);
+  }
+  BigIntegerArray level = PairwiseProducts();
+  while (level.Size() > 1) {
+    level = level.PairwiseProducts();
+  }
+  return level.At(0);
+}
+
+void BigIntegerArray::Sort() {
+  std::vector<size_t> order(Size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](size_t lhs,
+                                                      size_t rhs) {
+    if (signs_[lhs] != signs_[rhs]) {
+      return signs_[lhs] < signs_[rhs];
+    }
+    int magnitude = kernels::Compare(Data(lhs), Length(lhs),
+                                     Data(rhs), Length(rhs));
+    return magnitude * signs_[lhs] < 0;
+  });
+
+  BigIntegerArray sorted;
+  sorted.Reserve(Size(), LimbCount());
+  for (size_t index : order) {
+    sorted.AppendDigits(signs_[index], Data(index), Length(index));
+  }
+  *this = std::move(sorted);
+}
+
+}  // namespace big_num_arithmetic
@@ -0,0 +1,72 @@
+#ifndef BIG_INTEGER_ARRAY_H_
+#define BIG_INTEGER_ARRAY_H_
+
+#include "big_integer.h"
+#include <vector>
+
+namespace big_num_arithmetic {
+
+// Array of numbers in structure-of-arrays form: the digits of all elements
+// lie one after another in a single arena, and every element is only an
+// offset into it plus a sign. Unlike std::vector<BigInteger>, it makes one
+// allocation instead of one per element and scans the digits sequentially.
+class BigIntegerArray {
+ public:
+  BigIntegerArray() = default;
+  explicit BigIntegerArray(const std::vector<BigInteger>&);
+
+  // Reserves space for |size| elements having |limbs| digits in total.
+  void Reserve(size_t size, size_t limbs);
+  void PushBack(const BigInteger&);
+
+  size_t Size() const;
+  // Total number of digits in the arena.
+  size_t LimbCount() const;
+  int Sign(size_t) const;
+  BigInteger At(size_t) const;
+  std::vector<BigInteger> ToVector() const;
+
+  // ELEMENT-WISE OPERATIONS
+  // Both arrays must have the same size, std::invalid_argument is thrown
+  // otherwise.
+  BigIntegerArray operator+(const BigIntegerArray&) const;
+  BigIntegerArray operator-(const BigIntegerArray&) const;
+  BigIntegerArray operator*(const BigIntegerArray&) const;
+
+  BigIntegerArray operator+(const BigInteger&) const;
+  BigIntegerArray operator-(const BigInteger&) const;
+  BigIntegerArray operator*(const BigInteger&) const;
+
+  // REDUCTIONS
+  BigInteger Sum() const;
+  // The product is taken by a balanced tree of pairwise products, so the
+  // factors stay of similar size. The product of no elements is 1.
+  BigInteger Product() const;
+
+  // Sorts the elements in ascending order and compacts the arena.
+  void Sort();
+
+ private:
+  // Digits of element i are limbs_[offsets_[i], offsets_[i + 1]).
+  std::vector<uint32_t> limbs_;
+  std::vector<size_t> offsets_{0};
+  std::vector<int> signs_;
+
+  const uint32_t* Data(size_t) const;
+  size_t Length(size_t) const;
+
+  // Appends (sign, digits) + (rhs_sign, rhs) as a new element.
+  void AppendSum(int, const uint32_t*, size_t,
+                 int, const uint32_t*, size_t);
+  void AppendProduct(int, const uint32_t*, size_t,
+                     int, const uint32_t*, size_t);
+  // Appends digits that are already normalized.
+  void AppendDigits(int, const uint32_t*, size_t);
+
+  // Array of products of the neighbouring elements, a level of the tree.
+  BigIntegerArray PairwiseProducts() const;
+};
+
+}  // namespace big_num_arithmetic
+
+#endif  // BIG_INTEGER_ARRAY_H_
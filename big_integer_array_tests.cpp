@@ -0,0 +1,85 @@
+#include "big_integer_array.h"
+#include <gtest/gtest.h>
+
+namespace big_num_arithmetic {
+
+namespace {
+
+std::vector<BigInteger> ArrayValues() {
+  return {BigInteger::FromString("123456789012345678901234567890", 10),
+          BigInteger(0),
+          BigInteger(-17),
+          BigInteger::FromString("-98765432109876543210987654321", 10),
+          BigInteger(INT64_MAX),
+          BigInteger::FromString("-123456789012345678901234567890", 10)};
+}
+
+}  // namespace
+
+TEST(Test_22, ArrayStorage) {
+  std::vector<BigInteger> values = ArrayValues();
+  BigIntegerArray array(values);
+  EXPECT_EQ(array.Size(), values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_TRUE(array.At(i) == values[i]);
+    EXPECT_EQ(array.Sign(i), values[i].Sign());
+  }
+  array.PushBack(BigInteger(5));
+  EXPECT_TRUE(array.At(values.size()) == 5);
+  EXPECT_THROW(array.At(values.size() + 1), std::out_of_range);
+  EXPECT_THROW(array.At(SIZE_MAX), std::out_of_range);
+}
+
+TEST(Test_23, ArrayElementWiseOperations) {
+  std::vector<BigInteger> lhs = ArrayValues();
+  std::vector<BigInteger> rhs = ArrayValues();
+  std::reverse(rhs.begin(), rhs.end());
+  BigIntegerArray lhs_array(lhs);
+  BigIntegerArray rhs_array(rhs);
+  BigInteger scalar = BigInteger::FromString("-4294967296", 10);
+
+  BigIntegerArray sum = lhs_array + rhs_array;
+  BigIntegerArray difference = lhs_array - rhs_array;
+  BigIntegerArray product = lhs_array * rhs_array;
+  BigIntegerArray scalar_sum = lhs_array + scalar;
+  BigIntegerArray scalar_difference = lhs_array - scalar;
+  BigIntegerArray scalar_product = lhs_array * scalar;
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    EXPECT_TRUE(sum.At(i) == lhs[i] + rhs[i]);
+    EXPECT_TRUE(difference.At(i) == lhs[i] - rhs[i]);
+    EXPECT_TRUE(product.At(i) == lhs[i] * rhs[i]);
+    EXPECT_TRUE(scalar_sum.At(i) == lhs[i] + scalar);
+    EXPECT_TRUE(scalar_difference.At(i) == lhs[i] - scalar);
+    EXPECT_TRUE(scalar_product.At(i) == lhs[i] * scalar);
+  }
+  EXPECT_EQ(sum.Sign(0), 0);
+  EXPECT_THROW(lhs_array + BigIntegerArray(), std::invalid_argument);
+}
+
+TEST(Test_24, ArrayReductionsAndSorting) {
+  std::vector<BigInteger> values = ArrayValues();
+  BigIntegerArray array(values);
+  BigInteger sum(0);
+  BigInteger product(1);
+  for (const BigInteger& value : values) {
+    sum += value;
+    if (value != 0) {
+      product *= value;
+    }
+  }
+  EXPECT_TRUE(array.Sum() == sum);
+  EXPECT_TRUE(array.Product() == 0);
+  values.erase(values.begin() + 1);
+  EXPECT_TRUE(BigIntegerArray(values).Product() == product);
+  EXPECT_TRUE(BigIntegerArray().Product() == 1);
+  EXPECT_TRUE(BigIntegerArray().Sum() == 0);
+
+  array.Sort();
+  std::vector<BigInteger> sorted = ArrayValues();
+  std::sort(sorted.begin(), sorted.end());
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    EXPECT_TRUE(array.At(i) == sorted[i]);
+  }
+}
+
+}  // namespace big_num_arithmetic
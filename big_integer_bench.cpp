@@ -0,0 +1,498 @@
+#include "big_decimal.h"
+#include "big_integer.h"
+#include "big_integer_accumulator.h"
+#include "big_rational.h"
+#include "concurrent_counter.h"
+#include "divisor.h"
+#include "equation_solver.h"
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+// Microbenchmarks of BigInteger and the equation solver. The report is
+// printed as JSON, unless another --benchmark_format is given, so runs on
+// different machines and commits can be compared by tools; the complexity
+// fits (the "_BigO" entries) help to tune the algorithm thresholds.
+
+namespace big_num_arithmetic {
+
+namespace {
+
+// Operand sizes in digits go from 1 to 2^20 (about 10^6) by factors of 16.
+// Operations that are quadratic or worse stop earlier, so that a full run
+// takes minutes.
+const int64_t kSizeFactor = 16;
+const int64_t kMaxLimbs = int64_t{1} << 20;
+const int64_t kMaxStringLimbs = int64_t{1} << 12;
+const int64_t kMaxSqrtLimbs = int64_t{1} << 8;
+const int64_t kMaxSolveLimbs = int64_t{1} << 6;
+
+// A random number of exactly LIMBS digits. The operands depend only on the
+// seed, so every run measures the same numbers.
+BigInteger Operand(int64_t limbs, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  uint64_t bits = 32 * static_cast<uint64_t>(limbs);
+  return BigInteger::Random(bits, rng) | (BigInteger(1) << (bits - 1));
+}
+
+// CREATION
+
+void BM_ConstructInt64(benchmark::State& state) {
+  int64_t value = -1234567890123456789;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BigInteger(value));
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_ConstructInt64);
+
+void BM_FromLimbs(benchmark::State& state) {
+  std::vector<uint32_t> limbs = Operand(state.range(0), 1).Limbs();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BigInteger::FromLimbs(limbs.data(),
+                                                   limbs.size()));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_FromLimbs)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity(benchmark::oN);
+
+void BM_Copy(benchmark::State& state) {
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    BigInteger copy = value;
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Copy)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity(benchmark::oN);
+
+// STRING PROCESSING
+
+void BM_FromString(benchmark::State& state) {
+  int base = static_cast<int>(state.range(1));
+  std::string text = Operand(state.range(0), 1).ToString(base);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BigInteger::FromString(text, base));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(BM_FromString)->ArgsProduct({
+    benchmark::CreateRange(1, kMaxStringLimbs, kSizeFactor), {2, 10, 16}});
+
+void BM_ToString(benchmark::State& state) {
+  int base = static_cast<int>(state.range(1));
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value.ToString(base));
+  }
+}
+BENCHMARK(BM_ToString)->ArgsProduct({
+    benchmark::CreateRange(1, kMaxStringLimbs, kSizeFactor), {2, 10, 16}});
+
+// OPERATIONS
+
+void BM_Add(benchmark::State& state) {
+  BigInteger lhs = Operand(state.range(0), 1);
+  BigInteger rhs = Operand(state.range(0), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs + rhs);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Add)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity(benchmark::oN);
+
+void BM_Subtract(benchmark::State& state) {
+  BigInteger lhs = Operand(state.range(0), 1);
+  BigInteger rhs = Operand(state.range(0), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs - rhs);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Subtract)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity(benchmark::oN);
+
+void BM_Multiply(benchmark::State& state) {
+  BigInteger lhs = Operand(state.range(0), 1);
+  BigInteger rhs = Operand(state.range(0), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs * rhs);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Multiply)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// A numerator of twice the size of the divisor, the case of the
+// remainders of products.
+void BM_Divide(benchmark::State& state) {
+  BigInteger numerator = Operand(2 * state.range(0), 1);
+  BigInteger divisor = Operand(state.range(0), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(numerator / divisor);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Divide)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// The same quotients by a divisor prepared in advance.
+void BM_DivideByDivisor(benchmark::State& state) {
+  BigInteger numerator = Operand(2 * state.range(0), 1);
+  Divisor divisor(Operand(state.range(0), 2));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(numerator / divisor);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_DivideByDivisor)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// A numerator that is a multiple of the divisor, as in BM_Divide.
+void BM_DivExact(benchmark::State& state) {
+  BigInteger divisor = Operand(state.range(0), 2);
+  BigInteger numerator = Operand(state.range(0), 1) * divisor;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BigInteger::DivExact(numerator, divisor));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_DivExact)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxStringLimbs)->Complexity()->Unit(benchmark::kMicrosecond);
+
+void BM_Modulo(benchmark::State& state) {
+  BigInteger numerator = Operand(2 * state.range(0), 1);
+  BigInteger divisor = Operand(state.range(0), 2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(numerator - numerator / divisor * divisor);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Modulo)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// Equal values, so that every digit is compared.
+void BM_Compare(benchmark::State& state) {
+  BigInteger lhs = Operand(state.range(0), 1);
+  BigInteger rhs = lhs;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(lhs < rhs);
+    benchmark::DoNotOptimize(lhs == rhs);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Compare)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity(benchmark::oN);
+
+// OPERATIONS WITH SHORT NUMBERS
+
+const int64_t kShortNumber = 1000000007;
+
+void BM_AddInt64(benchmark::State& state) {
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value + kShortNumber);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_AddInt64)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity(benchmark::oN);
+
+void BM_MultiplyInt64(benchmark::State& state) {
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value * kShortNumber);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MultiplyInt64)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity(benchmark::oN);
+
+void BM_DivideInt64(benchmark::State& state) {
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value / kShortNumber);
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_DivideInt64)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity(benchmark::oN);
+
+void BM_ModuloDigit(benchmark::State& state) {
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value % uint32_t{1000000007});
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_ModuloDigit)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs)->Complexity(benchmark::oN);
+
+void BM_CompareInt64(benchmark::State& state) {
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(value < kShortNumber);
+  }
+}
+BENCHMARK(BM_CompareInt64)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxLimbs);
+
+// SUMS
+// 1024 terms of the given size, half of them negative.
+
+std::vector<BigInteger> Terms(int64_t limbs) {
+  std::vector<BigInteger> terms;
+  for (uint64_t seed = 0; seed < 1024; ++seed) {
+    terms.push_back(Operand(limbs, seed));
+    if (seed % 2 == 1) {
+      terms.back().Negate();
+    }
+  }
+  return terms;
+}
+
+void BM_SumByAdd(benchmark::State& state) {
+  std::vector<BigInteger> terms = Terms(state.range(0));
+  for (auto _ : state) {
+    BigInteger sum;
+    for (const BigInteger& term : terms) {
+      sum += term;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * terms.size());
+}
+BENCHMARK(BM_SumByAdd)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxStringLimbs);
+
+void BM_SumByAccumulator(benchmark::State& state) {
+  std::vector<BigInteger> terms = Terms(state.range(0));
+  for (auto _ : state) {
+    BigIntegerAccumulator accumulator;
+    for (const BigInteger& term : terms) {
+      accumulator += term;
+    }
+    benchmark::DoNotOptimize(accumulator.Result());
+  }
+  state.SetItemsProcessed(state.iterations() * terms.size());
+}
+BENCHMARK(BM_SumByAccumulator)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxStringLimbs);
+
+// DECIMALS
+// 1/3 and the square root of 2 to the given number of digits.
+
+void BM_DecimalDivide(benchmark::State& state) {
+  DecimalContext context{static_cast<uint64_t>(state.range(0))};
+  BigDecimal one(1);
+  BigDecimal three(3);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(one.Divide(three, context));
+  }
+}
+BENCHMARK(BM_DecimalDivide)->RangeMultiplier(kSizeFactor)
+    ->Range(16, 4096)->Unit(benchmark::kMicrosecond);
+
+void BM_DecimalSqrt(benchmark::State& state) {
+  DecimalContext context{static_cast<uint64_t>(state.range(0))};
+  BigDecimal two(2);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(two.Sqrt(context));
+  }
+}
+BENCHMARK(BM_DecimalSqrt)->RangeMultiplier(kSizeFactor)
+    ->Range(16, 4096)->Unit(benchmark::kMicrosecond);
+
+// RATIONAL SUMS
+// The harmonic number H_n = 1 + 1/2 + ... + 1/n with every normalization.
+
+void BM_HarmonicSum(benchmark::State& state) {
+  auto normalization = static_cast<BigRational::Normalization>(
+      state.range(1));
+  for (auto _ : state) {
+    BigRational sum(BigInteger(0), BigInteger(1), normalization);
+    for (int64_t k = 1; k <= state.range(0); ++k) {
+      sum += BigRational(BigInteger(1), BigInteger(k), normalization);
+    }
+    benchmark::DoNotOptimize(sum.Numerator());
+  }
+}
+BENCHMARK(BM_HarmonicSum)->ArgsProduct({
+    {100, 1000},
+    {static_cast<int64_t>(BigRational::Normalization::kEager),
+     static_cast<int64_t>(BigRational::Normalization::kLazy),
+     static_cast<int64_t>(BigRational::Normalization::kBySize)}})
+    ->Unit(benchmark::kMicrosecond);
+
+// CONCURRENT SUMS
+// Every thread adds int64_t terms to one total, which should scale with the
+// number of threads for the sharded counter.
+
+void BM_ShardedCounterAdd(benchmark::State& state) {
+  static ConcurrentCounter counter;
+  for (auto _ : state) {
+    counter.Add(kShortNumber);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ShardedCounterAdd)->ThreadRange(1, 64)->UseRealTime();
+
+void BM_LockedAdd(benchmark::State& state) {
+  static std::mutex mutex;
+  static BigInteger total;
+  for (auto _ : state) {
+    std::lock_guard<std::mutex> lock(mutex);
+    total += kShortNumber;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LockedAdd)->ThreadRange(1, 64)->UseRealTime();
+
+// EQUATION SOLVER
+
+void BM_Sqrt(benchmark::State& state) {
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(equation_solver::helpers::Sqrt(value));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Sqrt)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxSqrtLimbs)->Complexity()->Unit(benchmark::kMicrosecond);
+
+void BM_IRoot(benchmark::State& state) {
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BigInteger::IRoot(value, 2));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_IRoot)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxStringLimbs)->Complexity()->Unit(benchmark::kMicrosecond);
+
+void BM_ILog(benchmark::State& state) {
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BigInteger::ILog(value, 10));
+  }
+}
+BENCHMARK(BM_ILog)->RangeMultiplier(kSizeFactor)->Range(1, kMaxLimbs);
+
+// Random numbers, which are almost never powers.
+void BM_IsPerfectPower(benchmark::State& state) {
+  BigInteger value = Operand(state.range(0), 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BigInteger::IsPerfectPower(value));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_IsPerfectPower)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxStringLimbs)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// Roots and the leading coefficient have the given size.
+void BM_Solve(benchmark::State& state) {
+  equation_solver::QuadraticEquation equation =
+      equation_solver::GenerateEquation(Operand(state.range(0), 1),
+                                        Operand(state.range(0), 2),
+                                        -Operand(state.range(0), 3));
+  BigInteger root_1;
+  BigInteger root_2;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(equation_solver::Solve(equation, root_1,
+                                                    root_2));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_Solve)->RangeMultiplier(kSizeFactor)
+    ->Range(1, kMaxSolveLimbs)->Complexity()->Unit(benchmark::kMicrosecond);
+
+// POLYNOMIALS
+
+const int64_t kMaxDegree = int64_t{1} << 8;
+
+// COUNT roots of one digit with alternating signs.
+std::vector<BigInteger> SmallRoots(int64_t count, uint64_t seed) {
+  std::vector<BigInteger> roots;
+  for (int64_t i = 0; i < count; ++i) {
+    roots.push_back(Operand(1, seed + i) * (i % 2 == 0 ? 1 : -1));
+  }
+  return roots;
+}
+
+void BM_GeneratePolynomial(benchmark::State& state) {
+  std::vector<BigInteger> roots;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    roots.push_back(Operand(state.range(1), i));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        equation_solver::GenerateEquation(BigInteger(1), roots));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_GeneratePolynomial)->ArgsProduct({
+    benchmark::CreateRange(4, kMaxDegree, 4), {1, 4, 16}})
+    ->Unit(benchmark::kMicrosecond);
+
+// One polynomial at 16 points of the given size.
+void BM_PolynomialEvaluate(benchmark::State& state) {
+  equation_solver::PolynomialEquation equation =
+      equation_solver::GenerateEquation(BigInteger(1),
+                                        SmallRoots(state.range(0), 1));
+  std::vector<BigInteger> points;
+  for (uint64_t seed = 0; seed < 16; ++seed) {
+    points.push_back(Operand(state.range(1), 1000 + seed));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(equation_solver::Evaluate(equation, points));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_PolynomialEvaluate)->ArgsProduct({
+    benchmark::CreateRange(4, kMaxDegree, 4), {1, 4, 16, 64}})
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_SolvePolynomial(benchmark::State& state) {
+  equation_solver::PolynomialEquation equation =
+      equation_solver::GenerateEquation(BigInteger(3),
+                                        SmallRoots(state.range(0), 1));
+  std::vector<BigInteger> roots;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(equation_solver::Solve(equation, roots));
+  }
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_SolvePolynomial)->RangeMultiplier(4)
+    ->Range(4, kMaxDegree)->Complexity()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+
+}  // namespace big_num_arithmetic
+
+int main(int argc, char** argv) {
+  std::vector<char*> arguments(argv, argv + argc);
+  std::string json_format = "--benchmark_format=json";
+  bool has_format = false;
+  for (int i = 1; i < argc; ++i) {
+    has_format = has_format ||
+        std::strncmp(argv[i], "--benchmark_format", 18) == 0;
+  }
+  if (!has_format) {
+    arguments.push_back(json_format.data());
+  }
+  int size = static_cast<int>(arguments.size());
+  benchmark::Initialize(&size, arguments.data());
+  if (benchmark::ReportUnrecognizedArguments(size, arguments.data())) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
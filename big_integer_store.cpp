@@ -0,0 +1,270 @@
+#include "big_integer_store.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+namespace big_num_arithmetic {
+
+namespace {
+
+const char kMagic[8] = {'B', 'I', 'G', 'C', 'O', 'L', '0', '1'};
+const size_t kHeaderSize = 24;
+
+uint64_t LoadLittleEndian64(const char* data) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+  uint64_t value = 0;
+  for (int byte = 7; byte >= 0; --byte) {
+    value = (value << 8) | bytes[byte];
+  }
+  return value;
+}
+
+size_t SignBitmapSize(size_t count) {
+  return ((count + 7) / 8 + 3) / 4 * 4;
+}
+
+// Writes integers as little-endian bytes, converting them by chunks so that
+// the whole column is never duplicated in memory.
+template<typename T>
+void WriteLittleEndian(std::ofstream& output, const T* values, size_t size) {
+  const size_t kChunk = 4096;
+  std::vector<char> buffer;
+  buffer.reserve(kChunk * sizeof(T));
+  for (size_t begin = 0; begin < size; begin += kChunk) {
+    buffer.clear();
+    for (size_t i = begin; i < std::min(size, begin + kChunk); ++i) {
+      for (size_t byte = 0; byte < sizeof(T); ++byte) {
+        buffer.push_back(static_cast<char>(values[i] >> (8 * byte)));
+      }
+    }
+    output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  }
+}
+
+}  // namespace
+
+// BUILDER
+
+void BigIntegerStoreBuilder::Add(const BigInteger& big_int) {
+  size_t index = Size();
+  if (index % 8 == 0) {
+    signs_.push_back(0);
+  }
+  if (big_int.Sign() < 0) {
+    signs_.back() |= static_cast<unsigned char>(1 << (index % 8));
+  }
+  const std::vector<uint32_t>& limbs = big_int.Limbs();
+  limbs_.insert(limbs_.end(), limbs.begin(), limbs.end());
+  offsets_.push_back(limbs_.size());
+}
+
+size_t BigIntegerStoreBuilder::Size() const {
+  return offsets_.size() - 1;
+}
+
+void BigIntegerStoreBuilder::Write(const std::string& path) const {
+  std::ofstream output(path, std::ios::binary | std::ios::trunc);
+  if (!output) {
+    throw std::runtime_error("Cannot open " + path + " for writing");
+  }
+  uint64_t header[2] = {Size(), limbs_.size()};
+  output.write(kMagic, sizeof(kMagic));
+  WriteLittleEndian(output, header, 2);
+  WriteLittleEndian(output, offsets_.data(), offsets_.size());
+  std::vector<unsigned char> signs = signs_;
+  signs.resize(SignBitmapSize(Size()), 0);
+  output.write(reinterpret_cast<const char*>(signs.data()),
+               static_cast<std::streamsize>(signs.size()));
+  WriteLittleEndian(output, limbs_.data(), limbs_.size());
+  if (!output) {
+    throw std::runtime_error("Cannot write " + path);
+  }
+}
+
+// STORE
+
+BigIntegerStore BigIntegerStore::Open(const std::string& path) {
+  int file = open(path.c_str(), O_RDONLY);
+  if (file < 0) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+  struct stat file_stat{};
+  if (fstat(file, &file_stat) != 0 ||
+      static_cast<size_t>(file_stat.st_size) < kHeaderSize) {
+    close(file);
+    throw std::runtime_error("Malformed BigInteger store " + path);
+  }
+  size_t file_size = static_cast<size_t>(file_stat.st_size);
+  void* mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file, 0);
+  close(file);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("Cannot map " + path);
+  }
+  madvise(mapping, file_size, MADV_SEQUENTIAL);
+
+  BigIntegerStore store;
+  store.mapping_ = static_cast<const char*>(mapping);
+  store.mapping_size_ = file_size;
+
+  const char* data = store.mapping_;
+  uint64_t count = LoadLittleEndian64(data + 8);
+  uint64_t limb_count = LoadLittleEndian64(data + 16);
+  // Bounds are checked one by one, so that no size below can overflow.
+  bool valid = std::memcmp(data, kMagic, sizeof(kMagic)) == 0 &&
+      count < file_size / 8 && limb_count < file_size / 4;
+  size_t limbs_begin = 0;
+  if (valid) {
+    limbs_begin = kHeaderSize + (count + 1) * 8 + SignBitmapSize(count);
+    valid = limbs_begin + limb_count * 4 == file_size;
+  }
+  if (valid) {
+    store.size_ = count;
+    store.offsets_ = data + kHeaderSize;
+    store.signs_ = reinterpret_cast<const unsigned char*>(
+        data + kHeaderSize + (count + 1) * 8);
+    store.limbs_ = data + limbs_begin;
+    store.limb_count_ = limb_count;
+    // Only the ends are checked here, so that opening does not read the
+    // whole file; At() checks the offsets of every number it returns.
+    valid = store.Offset(0) == 0 && store.Offset(count) == limb_count;
+  }
+  if (!valid) {
+    throw std::runtime_error("Malformed BigInteger store " + path);
+  }
+  return store;
+}
+
+BigIntegerStore::BigIntegerStore(BigIntegerStore&& other) noexcept {
+  *this = std::move(other);
+}
+
+BigIntegerStore& BigIntegerStore::operator=(
+    BigIntegerStore&& other) noexcept {
+  std::swap(mapping_, other.mapping_);
+  std::swap(mapping_size_, other.mapping_size_);
+  std::swap(size_, other.size_);
+  std::swap(offsets_, other.offsets_);
+  std::swap(signs_, other.signs_);
+  std::swap(limbs_, other.limbs_);
+  std::swap(limb_count_, other.limb_count_);
+  return *this;
+}
+
+BigIntegerStore::~BigIntegerStore() {
+  if (mapping_ != nullptr) {
+    munmap(const_cast<char*>(mapping_), mapping_size_);
+  }
+}
+
+size_t BigIntegerStore::Size() const {
+  return size_;
+}
+
+uint64_t BigIntegerStore::Offset(size_t index) const {
+  return LoadLittleEndian64(offsets_ + 8 * index);
+}
+
+BigIntegerView BigIntegerStore::At(size_t index) const {
+  if (index >= size_) {
+    throw std::out_of_range("BigIntegerStore index out of range");
+  }
+  uint64_t begin = Offset(index);
+  uint64_t end = Offset(index + 1);
+  if (begin > end || end > limb_count_) {
+    throw std::runtime_error("Malformed BigInteger store offsets");
+  }
+  int sign = ((signs_[index / 8] >> (index % 8)) & 1) ? -1 : 1;
+  BigIntegerView view = BigIntegerView::FromLimbs(sign, limbs_ + 4 * begin,
+                                                  end - begin);
+  // As in BigIntegerView::Read(), the top limb of a number is never zero:
+  // the comparisons order by the number of limbs first.
+  if (begin != end && view.Limb(end - begin - 1) == 0) {
+    throw std::runtime_error("Malformed BigInteger store number");
+  }
+  return view;
+}
+
+// SCANS
+
+BigInteger BigIntegerStore::Sum() const {
+  // Keeping the signs apart makes every addition a plain carry chain.
+  BigInteger positive;
+  BigInteger negative;
+  for (size_t i = 0; i < size_; ++i) {
+    BigIntegerView view = At(i);
+    view.AddTo((view.Sign() < 0) ? negative : positive);
+  }
+  return positive + negative;
+}
+
+size_t BigIntegerStore::MinIndex() const {
+  if (size_ == 0) {
+    throw std::logic_error("Empty BigIntegerStore");
+  }
+  size_t result = 0;
+  BigIntegerView min = At(0);
+  for (size_t i = 1; i < size_; ++i) {
+    BigIntegerView view = At(i);
+    if (view < min) {
+      min = view;
+      result = i;
+    }
+  }
+  return result;
+}
+
+size_t BigIntegerStore::MaxIndex() const {
+  if (size_ == 0) {
+    throw std::logic_error("Empty BigIntegerStore");
+  }
+  size_t result = 0;
+  BigIntegerView max = At(0);
+  for (size_t i = 1; i < size_; ++i) {
+    BigIntegerView view = At(i);
+    if (view > max) {
+      max = view;
+      result = i;
+    }
+  }
+  return result;
+}
+
+std::vector<size_t> BigIntegerStore::Filter(
+    Comparison comparison, const BigInteger& threshold) const {
+  std::vector<size_t> result;
+  for (size_t i = 0; i < size_; ++i) {
+    int order = At(i).Compare(threshold);
+    bool matches = false;
+    switch (comparison) {
+      case Comparison::kLess:
+        matches = order < 0;
+        break;
+      case Comparison::kLessOrEqual:
+        matches = order <= 0;
+        break;
+      case Comparison::kEqual:
+        matches = order == 0;
+        break;
+      case Comparison::kNotEqual:
+        matches = order != 0;
+        break;
+      case Comparison::kGreaterOrEqual:
+        matches = order >= 0;
+        break;
+      case Comparison::kGreater:
+        matches = order > 0;
+        break;
+    }
+    if (matches) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+
+}  // namespace big_num_arithmetic
@@ -0,0 +1,88 @@
+#ifndef BIG_INTEGER_STORE_H_
+#define BIG_INTEGER_STORE_H_
+
+#include "big_integer.h"
+#include "big_integer_view.h"
+#include <string>
+#include <vector>
+
+namespace big_num_arithmetic {
+
+// COLUMNAR FILE FORMAT
+// All fields are little-endian:
+//  * header: 8 bytes of magic "BIGCOL01", uint64 count, uint64 limb_count;
+//  * (count + 1) uint64 offsets, number i has digits from offsets[i] up to
+//    offsets[i + 1] in the pool, zero has none;
+//  * sign bitmap of (count + 7) / 8 bytes, bit i is set for negative
+//    number i, padded with zeroes up to a multiple of 4 bytes;
+//  * pool of limb_count digits of BigInteger, 4 bytes each.
+
+// Collects numbers in memory in the columnar form and writes them to a file.
+class BigIntegerStoreBuilder {
+ public:
+  void Add(const BigInteger&);
+  size_t Size() const;
+
+  // Throws std::runtime_error if the file can't be written.
+  void Write(const std::string& path) const;
+
+ private:
+  std::vector<uint64_t> offsets_{0};
+  std::vector<unsigned char> signs_;
+  std::vector<uint32_t> limbs_;
+};
+
+// Read-only store, opened with mmap. Numbers are returned as views into the
+// mapping, the scans below never build BigInteger for single elements.
+class BigIntegerStore {
+ public:
+  enum class Comparison {
+    kLess,
+    kLessOrEqual,
+    kEqual,
+    kNotEqual,
+    kGreaterOrEqual,
+    kGreater
+  };
+
+  // Throws std::runtime_error if the file can't be mapped or its header and
+  // sizes are malformed. The numbers themselves are checked as they are
+  // read: At() and the scans throw std::runtime_error for bad offsets or a
+  // zero top limb.
+  static BigIntegerStore Open(const std::string& path);
+
+  BigIntegerStore(BigIntegerStore&&) noexcept;
+  BigIntegerStore& operator=(BigIntegerStore&&) noexcept;
+  BigIntegerStore(const BigIntegerStore&) = delete;
+  BigIntegerStore& operator=(const BigIntegerStore&) = delete;
+  ~BigIntegerStore();
+
+  size_t Size() const;
+  BigIntegerView At(size_t) const;
+
+  // SCANS
+  BigInteger Sum() const;
+  // Indexes of the smallest and the largest numbers, the first one among
+  // equal; throws std::logic_error for an empty store.
+  size_t MinIndex() const;
+  size_t MaxIndex() const;
+  // Indexes of numbers x for which "x comparison threshold" holds.
+  std::vector<size_t> Filter(Comparison, const BigInteger& threshold) const;
+
+ private:
+  BigIntegerStore() = default;
+
+  uint64_t Offset(size_t) const;
+
+  const char* mapping_{nullptr};
+  size_t mapping_size_{0};
+  size_t size_{0};
+  const char* offsets_{nullptr};
+  const unsigned char* signs_{nullptr};
+  const char* limbs_{nullptr};
+  uint64_t limb_count_{0};
+};
+
+}  // namespace big_num_arithmetic
+
+#endif  // BIG_INTEGER_STORE_H_
@@ -0,0 +1,117 @@
+#include "big_integer_store.h"
+#include <gtest/gtest.h>
+#include <fstream>
+#include <iterator>
+
+namespace big_num_arithmetic {
+
+namespace {
+
+std::vector<BigInteger> StoreValues() {
+  return {BigInteger::FromString("123456789012345678901234567890", 10),
+          BigInteger(0),
+          BigInteger(-17),
+          BigInteger::FromString("-98765432109876543210987654321", 10),
+          BigInteger(INT64_MAX),
+          BigInteger(42),
+          BigInteger::FromString("-98765432109876543210987654321", 10)};
+}
+
+}  // namespace
+
+TEST(Test_19, StoreRoundTrip) {
+  std::string path = testing::TempDir() + "big_integer_store_round_trip";
+  std::vector<BigInteger> values = StoreValues();
+  BigIntegerStoreBuilder builder;
+  for (const BigInteger& value : values) {
+    builder.Add(value);
+  }
+  EXPECT_EQ(builder.Size(), values.size());
+  builder.Write(path);
+
+  BigIntegerStore store = BigIntegerStore::Open(path);
+  ASSERT_EQ(store.Size(), values.size());
+  for (size_t i = 0; i < values.size(); ++i) {
+    EXPECT_TRUE(store.At(i).ToBigInteger() == values[i]);
+  }
+  EXPECT_ANY_THROW(store.At(values.size()));
+
+  BigIntegerStore moved = std::move(store);
+  EXPECT_TRUE(moved.At(0).ToBigInteger() == values[0]);
+}
+
+TEST(Test_20, StoreScans) {
+  std::string path = testing::TempDir() + "big_integer_store_scans";
+  std::vector<BigInteger> values = StoreValues();
+  BigIntegerStoreBuilder builder;
+  BigInteger sum(0);
+  for (const BigInteger& value : values) {
+    builder.Add(value);
+    sum += value;
+  }
+  builder.Write(path);
+  BigIntegerStore store = BigIntegerStore::Open(path);
+
+  EXPECT_TRUE(store.Sum() == sum);
+  EXPECT_EQ(store.MinIndex(), 3u);
+  EXPECT_EQ(store.MaxIndex(), 0u);
+  EXPECT_EQ(store.Filter(BigIntegerStore::Comparison::kLess, BigInteger(0)),
+            std::vector<size_t>({2, 3, 6}));
+  EXPECT_EQ(store.Filter(BigIntegerStore::Comparison::kGreaterOrEqual,
+                         BigInteger(42)),
+            std::vector<size_t>({0, 4, 5}));
+  EXPECT_EQ(store.Filter(BigIntegerStore::Comparison::kEqual, values[3]),
+            std::vector<size_t>({3, 6}));
+
+  BigIntegerStoreBuilder().Write(path);
+  BigIntegerStore empty = BigIntegerStore::Open(path);
+  EXPECT_EQ(empty.Size(), 0u);
+  EXPECT_TRUE(empty.Sum() == 0);
+  EXPECT_ANY_THROW(empty.MinIndex());
+}
+
+TEST(Test_21, StoreErrors) {
+  std::string path = testing::TempDir() + "big_integer_store_errors";
+  EXPECT_THROW(BigIntegerStore::Open(path + "_missing"),
+               std::runtime_error);
+  {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << "BIGCOL01 definitely not a store";
+  }
+  EXPECT_THROW(BigIntegerStore::Open(path), std::runtime_error);
+
+  // A number whose top limb is zero, and an offset past the pool. Open()
+  // checks the sizes only, the numbers are checked as they are read.
+  BigIntegerStoreBuilder builder;
+  builder.Add(BigInteger::FromString("4294967301", 10));
+  builder.Add(BigInteger(5));
+  builder.Write(path);
+  std::string bytes;
+  {
+    std::ifstream input(path, std::ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(input),
+                 std::istreambuf_iterator<char>());
+  }
+  bytes.replace(bytes.size() - 8, 4, 4, '\0');
+  {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << bytes;
+  }
+  BigIntegerStore store = BigIntegerStore::Open(path);
+  EXPECT_TRUE(store.At(1).ToBigInteger() == 5);
+  EXPECT_THROW(store.At(0), std::runtime_error);
+  EXPECT_THROW(store.Sum(), std::runtime_error);
+  EXPECT_THROW(store.MinIndex(), std::runtime_error);
+
+  // The offset of the second number is the second one after the header.
+  bytes[32] = '\x07';
+  {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << bytes;
+  }
+  store = BigIntegerStore::Open(path);
+  EXPECT_THROW(store.At(0), std::runtime_error);
+  EXPECT_THROW(store.At(1), std::runtime_error);
+}
+
+}  // namespace big_num_arithmetic
@@ -1,5 +1,8 @@
 #include "big_integer.h"
 #include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <unordered_set>
 
 namespace big_num_arithmetic {
 
@@ -387,9 +390,9 @@ TEST(Test_10, ToInt64Converting) {
     BigInteger still_too_long_big_int =
         BigInteger::FromString("-28194691286541826333789698656754874",
                                10);
-    EXPECT_THROW(int64_t x(too_long_big_int),
+    EXPECT_THROW([[maybe_unused]] int64_t x(too_long_big_int),
                  std::exception);
-    EXPECT_THROW(int64_t x(still_too_long_big_int),
+    EXPECT_THROW([[maybe_unused]] int64_t x(still_too_long_big_int),
                  std::exception);
   }
   {
@@ -405,7 +408,7 @@ TEST(Test_10, ToInt64Converting) {
 
     // Because |other_big_int| must be less than INT64_MAX,
     // according to the problem.
-    EXPECT_THROW(int64_t x(other_big_int),
+    EXPECT_THROW([[maybe_unused]] int64_t x(other_big_int),
                  std::exception);
   }
   {
@@ -420,5 +423,526 @@ TEST(Test_10, ToInt64Converting) {
   }
 }
 
+TEST(Test_15, ConstexprAndLiterals) {
+  using namespace literals;
+  static_assert(BigInteger(150) + BigInteger(-151) == -1);
+  static_assert(BigInteger(INT64_MAX) * BigInteger(INT64_MAX) >
+                BigInteger(INT64_MAX));
+  static_assert(123456789012345678901234567890_bi -
+                123456789012345678901234567889_bi == 1);
+  static_assert(0xffffffffffffffffffff_bi + 1_bi ==
+                0x1'0000'0000'0000'0000'0000_bi);
+  static_assert(-0777_bi == -511);
+  {
+    BigInteger value = 123456789012345678901234567890_bi;
+    EXPECT_EQ(value.ToString(10), "123456789012345678901234567890");
+    EXPECT_TRUE(value == BigInteger::FromString(
+        "123456789012345678901234567890", 10));
+    EXPECT_TRUE(0_bi == BigInteger());
+    EXPECT_TRUE((0_bi).Sign() == 0);
+  }
+}
+TEST(Test_25, SumProductAndFactorial) {
+  {
+    std::vector<BigInteger> values;
+    BigInteger sum(0);
+    BigInteger product(1);
+    for (int64_t i = -20; i <= 30; i += 3) {
+      BigInteger value = BigInteger(i) * BigInteger(INT64_MAX) * i;
+      values.push_back(value);
+      sum += value;
+      product *= value;
+    }
+    EXPECT_TRUE(BigInteger::Sum(values) == sum);
+    EXPECT_TRUE(BigInteger::Product(values) == product);
+    EXPECT_TRUE(BigInteger::Sum(std::vector<BigInteger>()) == 0);
+    EXPECT_TRUE(BigInteger::Product(std::vector<BigInteger>()) == 1);
+  }
+  {
+    EXPECT_TRUE(BigInteger::Factorial(0) == 1);
+    EXPECT_TRUE(BigInteger::Factorial(1) == 1);
+    EXPECT_TRUE(BigInteger::Factorial(20) == 2432902008176640000);
+    EXPECT_EQ(BigInteger::Factorial(30).ToString(10),
+              "265252859812191058636308480000000");
+    BigInteger factorial(1);
+    for (int64_t i = 2; i <= 500; ++i) {
+      factorial *= i;
+    }
+    EXPECT_TRUE(BigInteger::Factorial(500) == factorial);
+  }
+  {
+    EXPECT_TRUE(BigInteger::Binomial(5, 7) == 0);
+    EXPECT_TRUE(BigInteger::Binomial(5, 0) == 1);
+    EXPECT_TRUE(BigInteger::Binomial(5, 2) == 10);
+    EXPECT_EQ(BigInteger::Binomial(100, 50).ToString(10),
+              "100891344545564193334812497256");
+    EXPECT_TRUE(BigInteger::Binomial(1000, 300) ==
+                BigInteger::Factorial(1000) /
+                (BigInteger::Factorial(300) * BigInteger::Factorial(700)));
+    EXPECT_EQ(BigInteger::Binomial(1000000000000, 3).ToString(10),
+              "166666666666166666666667000000000000");
+    EXPECT_TRUE(BigInteger::Binomial(uint64_t{1} << 26, 0) == 1);
+    EXPECT_TRUE(BigInteger::Binomial(uint64_t{1} << 26, 2) ==
+                BigInteger(int64_t{1} << 25) * ((int64_t{1} << 26) - 1));
+    EXPECT_TRUE(BigInteger::Binomial(3000, 10) ==
+                BigInteger::Factorial(3000) /
+                (BigInteger::Factorial(10) * BigInteger::Factorial(2990)));
+  }
+}
+
+TEST(Test_26, LargeMultiplication) {
+  std::vector<uint32_t> lhs(1000);
+  std::vector<uint32_t> rhs(700);
+  uint32_t state = 12345;
+  for (uint32_t& limb : lhs) {
+    state = state * 1103515245 + 12345;
+    limb = state;
+  }
+  for (uint32_t& limb : rhs) {
+    state = state * 1103515245 + 12345;
+    limb = state | 1;
+  }
+  for (size_t rhs_size : {31, 32, 33, 100, 499, 500, 501, 700}) {
+    std::vector<uint32_t> expected(lhs.size() + rhs_size);
+    kernels::SchoolbookMultiply(lhs.data(), lhs.size(), rhs.data(), rhs_size,
+                                expected.data());
+    BigInteger product = BigInteger::FromLimbs(lhs.data(), lhs.size()) *
+        BigInteger::FromLimbs(rhs.data(), rhs_size);
+    EXPECT_TRUE(product == BigInteger::FromLimbs(expected.data(),
+                                                 expected.size()));
+  }
+}
+
+TEST(Test_30, BitOperations) {
+  using namespace literals;
+  {
+    EXPECT_TRUE((BigInteger(1) << 100) ==
+                0x10'0000'0000'0000'0000'0000'0000_bi);
+    EXPECT_TRUE((BigInteger(-3) << 33) == -25769803776);
+    EXPECT_TRUE((0x10'0000'0000'0000'0000'0000'0001_bi >> 100) == 1);
+    EXPECT_TRUE((BigInteger(-7) >> 1) == -4);
+    EXPECT_TRUE((BigInteger(-8) >> 3) == -1);
+    EXPECT_TRUE((BigInteger(-8) >> 1000) == -1);
+    EXPECT_TRUE((BigInteger(8) >> 1000) == 0);
+    BigInteger value = BigInteger::FromString("-123456789012345678901234567890",
+                                              10);
+    value <<= 77;
+    value >>= 77;
+    EXPECT_EQ(value.ToString(10), "-123456789012345678901234567890");
+  }
+  {
+    EXPECT_TRUE((BigInteger(12) & BigInteger(10)) == 8);
+    EXPECT_TRUE((BigInteger(12) | BigInteger(10)) == 14);
+    EXPECT_TRUE((BigInteger(12) ^ BigInteger(10)) == 6);
+    EXPECT_TRUE((BigInteger(-12) & BigInteger(10)) == (-12 & 10));
+    EXPECT_TRUE((BigInteger(-12) | BigInteger(10)) == (-12 | 10));
+    EXPECT_TRUE((BigInteger(-12) ^ BigInteger(-10)) == (-12 ^ -10));
+    EXPECT_TRUE(~BigInteger(0) == -1);
+    EXPECT_TRUE(~BigInteger(-1) == 0);
+    BigInteger big = (BigInteger(1) << 200) - 1;
+    EXPECT_TRUE((big & BigInteger(-1)) == big);
+    EXPECT_TRUE((-big & big) == 1);
+    EXPECT_TRUE((big ^ big) == 0);
+    EXPECT_TRUE((-big | big) == -1);
+  }
+  {
+    EXPECT_EQ(BigInteger(0).BitLength(), 0u);
+    EXPECT_EQ(BigInteger(-1).BitLength(), 1u);
+    EXPECT_EQ((BigInteger(1) << 64).BitLength(), 65u);
+    EXPECT_EQ(BigInteger(-255).PopCount(), 8u);
+    EXPECT_EQ(((BigInteger(1) << 200) - 1).PopCount(), 200u);
+    EXPECT_EQ(BigInteger(0).CountTrailingZeros(), 0u);
+    EXPECT_EQ((BigInteger(-3) << 70).CountTrailingZeros(), 70u);
+    EXPECT_TRUE(BigInteger(5).TestBit(2));
+    EXPECT_FALSE(BigInteger(5).TestBit(1));
+    EXPECT_FALSE(BigInteger(5).TestBit(500));
+    EXPECT_TRUE(BigInteger(-6).TestBit(1));
+    EXPECT_FALSE(BigInteger(-6).TestBit(2));
+    EXPECT_TRUE(BigInteger(-6).TestBit(500));
+  }
+}
+
+TEST(Test_31, NativeConversions) {
+  {
+    EXPECT_EQ(BigInteger(INT64_MIN).ToInt64(), INT64_MIN);
+    EXPECT_EQ(BigInteger(INT64_MAX).ToInt64(), INT64_MAX);
+    EXPECT_TRUE(BigInteger(INT64_MIN).FitsInt64());
+    EXPECT_FALSE((BigInteger(INT64_MIN) - 1).FitsInt64());
+    EXPECT_THROW((BigInteger(INT64_MAX) + 1).ToInt64(), std::runtime_error);
+    EXPECT_EQ((BigInteger(INT64_MAX) + 1).TryToInt64(), std::nullopt);
+    EXPECT_EQ(BigInteger(-5).TryToInt64(), -5);
+  }
+  {
+    EXPECT_EQ(BigInteger(UINT64_MAX).ToUInt64(), UINT64_MAX);
+    EXPECT_EQ(BigInteger(UINT64_MAX).ToString(10), "18446744073709551615");
+    EXPECT_EQ(BigInteger(-1).TryToUInt64(), std::nullopt);
+    EXPECT_THROW((BigInteger(UINT64_MAX) + 1).ToUInt64(), std::runtime_error);
+  }
+  {
+    __int128 min = static_cast<__int128>(
+        static_cast<unsigned __int128>(1) << 127);
+    __int128 max = ~min;
+    EXPECT_TRUE(BigInteger(max) == (BigInteger(1) << 127) - 1);
+    EXPECT_TRUE(BigInteger(min) == -(BigInteger(1) << 127));
+    EXPECT_TRUE(BigInteger(max).ToInt128() == max);
+    EXPECT_TRUE(BigInteger(min).ToInt128() == min);
+    EXPECT_FALSE((BigInteger(max) + 1).TryToInt128().has_value());
+  }
+  {
+    EXPECT_EQ(BigInteger(0).ToDouble(), 0.0);
+    EXPECT_EQ(BigInteger(-12345).ToDouble(), -12345.0);
+    EXPECT_EQ((BigInteger(1) << 1000).ToDouble(), std::ldexp(1.0, 1000));
+    // 2^53 + 1 is a tie between 2^53 and 2^53 + 2, it goes to the even one;
+    // any lower bit set breaks the tie upwards.
+    BigInteger tie = (BigInteger(1) << 53) + 1;
+    EXPECT_EQ(tie.ToDouble(), 9007199254740992.0);
+    EXPECT_EQ(((tie << 100) + 1).ToDouble(),
+              std::ldexp(9007199254740994.0, 100));
+    EXPECT_EQ((BigInteger(1) << 1024).ToDouble(), HUGE_VAL);
+    EXPECT_EQ((-(BigInteger(1) << 5000)).ToDouble(), -HUGE_VAL);
+  }
+  {
+    EXPECT_TRUE(BigInteger(-2.75) == -2);
+    EXPECT_TRUE(BigInteger(0.5) == 0);
+    EXPECT_EQ(BigInteger(1e20).ToString(10), "100000000000000000000");
+    EXPECT_TRUE(BigInteger(std::ldexp(-3.0, 200)) == -(BigInteger(3) << 200));
+    EXPECT_THROW(BigInteger{std::nan("")}, std::runtime_error);
+    EXPECT_THROW(BigInteger{HUGE_VAL}, std::runtime_error);
+  }
+}
+
+TEST(Test_32, GcdAndModInverse) {
+  {
+    EXPECT_TRUE(BigInteger::Gcd(BigInteger(0), BigInteger(0)) == 0);
+    EXPECT_TRUE(BigInteger::Gcd(BigInteger(0), BigInteger(-7)) == 7);
+    EXPECT_TRUE(BigInteger::Gcd(BigInteger(-12), BigInteger(18)) == 6);
+    BigInteger common = BigInteger::Factorial(300);
+    BigInteger lhs = common * (BigInteger(1) << 5000) + common;
+    BigInteger rhs = common * BigInteger::Binomial(3000, 1000) * 7;
+    BigInteger gcd = BigInteger::Gcd(lhs, rhs);
+    EXPECT_TRUE(lhs / gcd * gcd == lhs);
+    EXPECT_TRUE(rhs / gcd * gcd == rhs);
+    EXPECT_TRUE(BigInteger::Gcd(lhs / gcd, rhs / gcd) == 1);
+  }
+  {
+    // Consecutive Fibonacci numbers need the most steps of all.
+    BigInteger previous(1);
+    BigInteger current(1);
+    for (int i = 0; i < 50000; ++i) {
+      std::swap(previous, current);
+      current += previous;
+    }
+    BigInteger x;
+    BigInteger y;
+    EXPECT_TRUE(BigInteger::ExtendedGcd(current, previous, x, y) == 1);
+    EXPECT_TRUE(current * x + previous * y == 1);
+    EXPECT_TRUE(x >= 0 && x < previous);
+  }
+  {
+    BigInteger x;
+    BigInteger y;
+    EXPECT_TRUE(BigInteger::ExtendedGcd(BigInteger(-240), BigInteger(46),
+                                        x, y) == 2);
+    EXPECT_TRUE(x == 9 && y == 47);
+    EXPECT_TRUE(BigInteger::ExtendedGcd(BigInteger(-5), BigInteger(0),
+                                        x, y) == 5);
+    EXPECT_TRUE(x == -1 && y == 0);
+  }
+  {
+    EXPECT_TRUE(BigInteger::ModInverse(BigInteger(3), BigInteger(11)) == 4);
+    EXPECT_TRUE(BigInteger::ModInverse(BigInteger(-3), BigInteger(11)) == 7);
+    BigInteger prime = (BigInteger(1) << 521) - 1;
+    BigInteger value = BigInteger::Factorial(100);
+    BigInteger inverse = BigInteger::ModInverse(value, prime);
+    BigInteger product = value * inverse - 1;
+    EXPECT_TRUE(product / prime * prime == product);
+    EXPECT_THROW(BigInteger::ModInverse(BigInteger(6), BigInteger(9)),
+                 std::runtime_error);
+    EXPECT_THROW(BigInteger::ModInverse(BigInteger(6), BigInteger(0)),
+                 DivisionByZeroError);
+  }
+}
+
+TEST(Test_35, PrimesAndNextPrime) {
+  for (int value : {2, 3, 5, 53, 4093, 65537, 1000003}) {
+    EXPECT_TRUE(BigInteger(value).IsProbablePrime());
+  }
+  for (int value : {-7, 0, 1, 4, 49, 4096, 4097, 16752649, 16850989}) {
+    EXPECT_FALSE(BigInteger(value).IsProbablePrime());
+  }
+  // Strong pseudoprimes to base 2 without small factors, the second one
+  // also to the bases 3, 5 and 7; the Lucas test rules them out.
+  EXPECT_FALSE(BigInteger(36307981).IsProbablePrime());
+  EXPECT_FALSE(BigInteger(int64_t{3215031751}).IsProbablePrime());
+  EXPECT_FALSE(BigInteger(int64_t{3215031751}).IsProbablePrime(5));
+
+  BigInteger mersenne = (BigInteger(1) << 127) - 1;
+  EXPECT_TRUE(mersenne.IsProbablePrime());
+  EXPECT_TRUE(mersenne.IsProbablePrime(10));
+  EXPECT_FALSE((mersenne * mersenne).IsProbablePrime());
+  EXPECT_FALSE((mersenne * ((BigInteger(1) << 89) - 1)).IsProbablePrime());
+  EXPECT_TRUE(((BigInteger(1) << 521) - 1).IsProbablePrime());
+
+  EXPECT_TRUE(BigInteger(-10).NextPrime() == 2);
+  EXPECT_TRUE(BigInteger(2).NextPrime() == 3);
+  EXPECT_TRUE(BigInteger(48).NextPrime() == 53);
+  EXPECT_TRUE(BigInteger(4093).NextPrime() == 4099);
+  EXPECT_TRUE(BigInteger(16777213).NextPrime() == 16777259);
+  EXPECT_TRUE((BigInteger(1) << 64).NextPrime() == (BigInteger(1) << 64) + 13);
+  EXPECT_TRUE(mersenne.NextPrime().IsProbablePrime());
+  EXPECT_TRUE((mersenne - 1).NextPrime() == mersenne);
+}
+
+TEST(Test_37, RandomNumbers) {
+  std::mt19937_64 rng(2024);
+  EXPECT_TRUE(BigInteger::Random(0, rng) == 0);
+  bool top_bit_seen = false;
+  for (uint64_t bits : {1, 31, 32, 33, 64, 100, 1000}) {
+    for (int i = 0; i < 20; ++i) {
+      BigInteger value = BigInteger::Random(bits, rng);
+      EXPECT_TRUE(value >= 0);
+      EXPECT_LE(value.BitLength(), bits);
+      top_bit_seen = top_bit_seen || value.BitLength() == bits;
+    }
+  }
+  EXPECT_TRUE(top_bit_seen);
+
+  {
+    std::vector<int> counts(6, 0);
+    for (int i = 0; i < 6000; ++i) {
+      counts[BigInteger::RandomBelow(BigInteger(6), rng).ToInt64()]++;
+    }
+    for (int count : counts) {
+      EXPECT_GT(count, 850);
+      EXPECT_LT(count, 1150);
+    }
+    EXPECT_TRUE(BigInteger::RandomBelow(BigInteger(1), rng) == 0);
+    BigInteger bound = (BigInteger(1) << 256) + 1;
+    for (int i = 0; i < 100; ++i) {
+      BigInteger value = BigInteger::RandomBelow(bound, rng);
+      EXPECT_TRUE(value >= 0 && value < bound);
+    }
+    EXPECT_THROW(BigInteger::RandomBelow(BigInteger(0), rng),
+                 std::invalid_argument);
+    EXPECT_THROW(BigInteger::RandomBelow(BigInteger(-3), rng),
+                 std::invalid_argument);
+  }
+
+  // Random operands make differential checks of the arithmetic cheap.
+  for (int i = 0; i < 200; ++i) {
+    BigInteger lhs = BigInteger::Random(rng() % 3000, rng);
+    BigInteger rhs = BigInteger::Random(rng() % 3000 + 1, rng) + 1;
+    if (rng() % 2 == 0) {
+      lhs = -lhs;
+    }
+    BigInteger quotient = lhs / rhs;
+    BigInteger remainder = lhs - quotient * rhs;
+    EXPECT_TRUE(remainder > -rhs && remainder < rhs);
+    EXPECT_TRUE((lhs * rhs) / rhs == lhs);
+    EXPECT_TRUE((lhs + rhs) - rhs == lhs);
+    EXPECT_TRUE(BigInteger::FromString(lhs.ToString(16), 16) == lhs);
+  }
+}
+
+TEST(Test_39, ThreeWayComparison) {
+  BigInteger big = BigInteger(1) << 100;
+  EXPECT_TRUE((big <=> -big) == std::strong_ordering::greater);
+  EXPECT_TRUE((-big <=> big) == std::strong_ordering::less);
+  EXPECT_TRUE((-big <=> -big) == std::strong_ordering::equal);
+  EXPECT_TRUE((-big <=> -(big + 1)) == std::strong_ordering::greater);
+  EXPECT_TRUE((BigInteger(0) <=> BigInteger(0)) == 0);
+  EXPECT_EQ(BigInteger::CompareMagnitude(-big, big), 0);
+  EXPECT_EQ(BigInteger::CompareMagnitude(BigInteger(-7), BigInteger(5)), 1);
+  EXPECT_EQ(BigInteger::CompareMagnitude(BigInteger(0), BigInteger(-1)), -1);
+
+  BigInteger int64_min(INT64_MIN);
+  EXPECT_TRUE(int64_min == INT64_MIN);
+  EXPECT_TRUE(int64_min < INT64_MIN + 1);
+  EXPECT_TRUE(int64_min - 1 < INT64_MIN);
+  EXPECT_TRUE(BigInteger(INT64_MAX) + 1 > INT64_MAX);
+  EXPECT_TRUE(BigInteger(UINT64_MAX) > INT64_MAX);
+  EXPECT_TRUE(-BigInteger(UINT64_MAX) < INT64_MIN);
+  EXPECT_TRUE(big > INT64_MAX && -big < INT64_MIN);
+  EXPECT_TRUE(BigInteger(0) == 0 && BigInteger(0) >= 0 && BigInteger(0) <= 0);
+  EXPECT_TRUE(5 < BigInteger(6) && -5 > BigInteger(-6) && 7 != BigInteger(8));
+  EXPECT_TRUE((BigInteger(-3) <=> -3) == 0);
+  EXPECT_TRUE((-3 <=> BigInteger(-2)) < 0);
+
+  std::vector<BigInteger> values;
+  for (int64_t i = -20; i <= 20; ++i) {
+    values.push_back(big * (i * 37 % 11) + i);
+  }
+  std::sort(values.begin(), values.end());
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end(),
+                             [](const BigInteger& lhs, const BigInteger& rhs) {
+                               return (lhs - rhs).Sign() < 0;
+                             }));
+  EXPECT_TRUE(big - (big + 5) == -5);
+  EXPECT_TRUE(-big + (big - 5) == -5);
+}
+
+TEST(Test_41, Hashing) {
+  std::hash<BigInteger> hash;
+  EXPECT_EQ(hash(BigInteger(0)), hash(BigInteger(5) - 5));
+  EXPECT_EQ(hash(-BigInteger(0)), hash(BigInteger()));
+  EXPECT_EQ(hash(BigInteger(1) << 100), hash(BigInteger::FromString(
+      "1267650600228229401496703205376", 10)));
+  // Leading zeros are dropped, so they don't change the hash.
+  uint32_t limbs[] = {7, 0, 0, 0, 0};
+  EXPECT_EQ(hash(BigInteger::FromLimbs(limbs, 5)), hash(BigInteger(7)));
+  EXPECT_NE(hash(BigInteger(7)), hash(BigInteger(-7)));
+  EXPECT_NE(hash(BigInteger(1)), hash(BigInteger(uint64_t{1} << 32)));
+  static_assert(BigInteger(12345).Hash() == BigInteger(12345).Hash());
+
+  std::unordered_set<BigInteger> values;
+  std::unordered_set<size_t> hashes;
+  BigInteger base = BigInteger(1) << 200;
+  for (int64_t i = -500; i < 500; ++i) {
+    values.insert(BigInteger(i));
+    values.insert(base + i);
+    values.insert(BigInteger(i) << 64);
+    hashes.insert(hash(BigInteger(i)));
+    hashes.insert(hash(base + i));
+    hashes.insert(hash(BigInteger(i) << 64));
+  }
+  EXPECT_EQ(values.size(), 2999u);
+  EXPECT_EQ(hashes.size(), 2999u);
+  EXPECT_EQ(values.count(base - 500), 1u);
+  EXPECT_EQ(values.count(base + 500), 0u);
+}
+
+TEST(Test_44, ExactDivision) {
+  EXPECT_THROW(BigInteger::DivExact(BigInteger(6), BigInteger(0)),
+               DivisionByZeroError);
+  EXPECT_TRUE(BigInteger::DivExact(BigInteger(0), BigInteger(7)) == 0);
+  EXPECT_TRUE(BigInteger::DivExact(BigInteger(-42), BigInteger(6)) == -7);
+  EXPECT_TRUE(BigInteger::DivExact(BigInteger(42), BigInteger(-7)) == -6);
+  EXPECT_TRUE(BigInteger::DivExact(BigInteger(1) << 200,
+                                   BigInteger(1) << 136) ==
+              BigInteger(1) << 64);
+
+  std::mt19937_64 rng(44);
+  for (int i = 0; i < 300; ++i) {
+    BigInteger quotient = BigInteger::Random(1 + rng() % 2000, rng);
+    BigInteger divisor = BigInteger::Random(1 + rng() % 2000, rng) + 1;
+    // Even divisors, so that the factor of two is taken out.
+    divisor <<= rng() % 70;
+    if (i % 3 == 0) {
+      quotient.Negate();
+    }
+    if (i % 5 == 0) {
+      divisor.Negate();
+    }
+    EXPECT_TRUE(BigInteger::DivExact(quotient * divisor, divisor) ==
+                quotient);
+    EXPECT_TRUE((quotient * divisor) / divisor == quotient);
+  }
+  // Long enough for the recursive division.
+  BigInteger quotient = -BigInteger::Random(32 * 1100, rng);
+  BigInteger divisor = BigInteger::Random(32 * 1100, rng) << 3;
+  EXPECT_TRUE(BigInteger::DivExact(quotient * divisor, divisor) == quotient);
+}
+
+TEST(Test_49, RootsAndLogarithms) {
+  auto power = [](const BigInteger& base, uint64_t exponent) {
+    BigInteger result(1);
+    for (uint64_t i = 0; i < exponent; ++i) {
+      result *= base;
+    }
+    return result;
+  };
+  EXPECT_THROW(BigInteger::IRoot(BigInteger(8), 0), std::invalid_argument);
+  EXPECT_THROW(BigInteger::IRoot(BigInteger(-8), 2), std::runtime_error);
+  EXPECT_THROW(BigInteger::ILog(BigInteger(0), 10), std::invalid_argument);
+  EXPECT_THROW(BigInteger::ILog(BigInteger(8), 1), std::invalid_argument);
+  EXPECT_TRUE(BigInteger::IRoot(BigInteger(0), 5) == 0);
+  EXPECT_TRUE(BigInteger::IRoot(BigInteger(-28), 3) == -3);
+  EXPECT_TRUE(BigInteger::IRoot(BigInteger(-27), 3) == -3);
+  EXPECT_TRUE(BigInteger::IRoot(BigInteger(1) << 100, 7) == 19972);
+  for (int64_t value = 1; value < 5000; ++value) {
+    for (uint64_t k = 1; k < 15; ++k) {
+      BigInteger root = BigInteger::IRoot(BigInteger(value), k);
+      ASSERT_TRUE(power(root, k) <= value && power(root + 1, k) > value);
+    }
+  }
+
+  std::mt19937_64 rng(49);
+  for (int i = 0; i < 200; ++i) {
+    BigInteger value = BigInteger::Random(1 + rng() % 20000, rng) + 1;
+    uint64_t k = 2 + rng() % 12;
+    BigInteger root = BigInteger::IRoot(value, k);
+    EXPECT_TRUE(power(root, k) <= value && power(root + 1, k) > value);
+    // Exact powers and their neighbours.
+    BigInteger exact = power(root, k);
+    EXPECT_TRUE(BigInteger::IRoot(exact, k) == root);
+    EXPECT_TRUE(BigInteger::IRoot(exact - 1, k) == root - 1);
+  }
+
+  EXPECT_EQ(BigInteger::ILog(BigInteger(1), 10), 0u);
+  EXPECT_EQ(BigInteger::ILog(BigInteger(1) << 1000, 2), 1000u);
+  EXPECT_EQ(BigInteger::ILog((BigInteger(1) << 1000) - 1, 16), 249u);
+  BigInteger ten_power(1);
+  for (uint64_t n = 0; n < 400; ++n) {
+    if (n > 0) {
+      EXPECT_EQ(BigInteger::ILog(ten_power - 1, 10), n - 1);
+    }
+    EXPECT_EQ(BigInteger::ILog(ten_power, 10), n);
+    EXPECT_EQ(BigInteger::ILog(ten_power + 1, 10), n);
+    EXPECT_EQ(BigInteger::ILog(ten_power * ten_power, 100), n);
+    ten_power *= 10;
+  }
+  for (int i = 0; i < 200; ++i) {
+    BigInteger value = BigInteger::Random(1 + rng() % 5000, rng) + 1;
+    uint64_t base = 2 + rng() % 1000;
+    uint64_t log = BigInteger::ILog(value, base);
+    BigInteger base_power = power(BigInteger(base), log);
+    EXPECT_TRUE(base_power <= value && base_power * base > value);
+  }
+
+  BigInteger root;
+  uint64_t exponent = 0;
+  EXPECT_TRUE(BigInteger::IsPerfectPower(BigInteger(1), root, exponent));
+  EXPECT_TRUE(root == 1 && exponent == 2);
+  EXPECT_TRUE(BigInteger::IsPerfectPower(BigInteger(-1), root, exponent));
+  EXPECT_TRUE(root == -1 && exponent == 3);
+  EXPECT_FALSE(BigInteger::IsPerfectPower(BigInteger(2)));
+  EXPECT_FALSE(BigInteger::IsPerfectPower(BigInteger(-4)));
+  EXPECT_FALSE(BigInteger::IsPerfectPower(BigInteger(72)));
+  EXPECT_TRUE(BigInteger::IsPerfectPower(BigInteger(1) << 60, root,
+                                         exponent));
+  EXPECT_TRUE(root == 2 && exponent == 60);
+  EXPECT_TRUE(BigInteger::IsPerfectPower(BigInteger(-1) << 63, root,
+                                         exponent));
+  EXPECT_TRUE(root == -2 && exponent == 63);
+  // 2^7 3^14 = 18^7.
+  EXPECT_TRUE(BigInteger::IsPerfectPower(power(BigInteger(2), 7) *
+                                         power(BigInteger(3), 14),
+                                         root, exponent));
+  EXPECT_TRUE(root == 18 && exponent == 7);
+  for (int64_t value = 2; value < 3000; ++value) {
+    bool is_power = false;
+    for (int64_t base = 2; base * base <= value && !is_power; ++base) {
+      for (int64_t product = base * base; product <= value;
+           product *= base) {
+        is_power = is_power || product == value;
+      }
+    }
+    ASSERT_EQ(BigInteger::IsPerfectPower(BigInteger(value)), is_power);
+  }
+  for (int i = 0; i < 100; ++i) {
+    // A root that is not a power itself, as 2^k + 1 never is but for 9.
+    BigInteger base = (BigInteger(1) << (4 + rng() % 1000)) + 1;
+    uint64_t k = 2 + rng() % 40;
+    BigInteger value = power(base, k);
+    if (i % 2 == 0 && k % 2 == 1) {
+      base.Negate();
+      value.Negate();
+    }
+    EXPECT_TRUE(BigInteger::IsPerfectPower(value, root, exponent));
+    EXPECT_TRUE(root == base && exponent == k);
+    EXPECT_FALSE(BigInteger::IsPerfectPower(value + 1));
+    EXPECT_FALSE(BigInteger::IsPerfectPower(value - 2));
+  }
+}
 
 }  // namespace big_num_arithmetic
@@ -0,0 +1,268 @@
+#include "big_integer_view.h"
+#include <stdexcept>
+
+namespace big_num_arithmetic {
+
+namespace {
+
+// Numbers below this bound are stored inside the header.
+const uint64_t kSmallLimit = uint64_t{1} << 62;
+
+void AppendVarint(uint64_t value, std::string& buffer) {
+  while (value >= 0x80) {
+    buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<char>(value));
+}
+
+size_t VarintSize(uint64_t value) {
+  size_t size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+uint64_t ReadVarint(const unsigned char* data, size_t size, size_t* index) {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (*index >= size) {
+      throw std::runtime_error("Truncated BigInteger record");
+    }
+    unsigned char byte = data[(*index)++];
+    // The tenth byte holds the top bit only.
+    if (shift == 63 && (byte & 0x7e) != 0) {
+      break;
+    }
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return value;
+    }
+  }
+  throw std::runtime_error("Malformed BigInteger header");
+}
+
+// Magnitude of a number that has at most two digits.
+uint64_t SmallMagnitude(const std::vector<uint32_t>& digits) {
+  uint64_t magnitude = 0;
+  for (size_t i = digits.size(); i-- > 0;) {
+    magnitude = magnitude * BigInteger::internal_base + digits[i];
+  }
+  return magnitude;
+}
+
+bool IsSmall(const std::vector<uint32_t>& digits) {
+  return digits.size() <= 2 && SmallMagnitude(digits) < kSmallLimit;
+}
+
+}  // namespace
+
+// BINARY FORMAT
+
+void AppendBinary(const BigInteger& big_int, std::string& buffer) {
+  uint64_t negative = (big_int.sign_ < 0) ? 1 : 0;
+  if (IsSmall(big_int.digits_)) {
+    AppendVarint((SmallMagnitude(big_int.digits_) << 2) | (negative << 1),
+                 buffer);
+    return;
+  }
+  AppendVarint((big_int.digits_.size() << 2) | (negative << 1) | 1, buffer);
+  for (uint32_t digit : big_int.digits_) {
+    for (int byte = 0; byte < 4; ++byte) {
+      buffer.push_back(static_cast<char>(digit >> (8 * byte)));
+    }
+  }
+}
+
+size_t BinarySize(const BigInteger& big_int) {
+  if (IsSmall(big_int.digits_)) {
+    return VarintSize(SmallMagnitude(big_int.digits_) << 2);
+  }
+  return VarintSize((big_int.digits_.size() << 2) | 1) +
+      4 * big_int.digits_.size();
+}
+
+BigInteger FromBinary(const std::string& buffer) {
+  return BigIntegerView::Read(buffer.data(), buffer.size()).ToBigInteger();
+}
+
+// VIEW
+
+BigIntegerView BigIntegerView::Read(const char* data, size_t size,
+                                    size_t* consumed) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+  size_t index = 0;
+  uint64_t header = ReadVarint(bytes, size, &index);
+
+  BigIntegerView view;
+  int sign = (header & 2) ? -1 : 1;
+  if (!(header & 1)) {
+    view.small_ = header >> 2;
+    view.size_ = (view.small_ == 0) ? 0 : (view.small_ >> 32) ? 2 : 1;
+  } else {
+    view.size_ = header >> 2;
+    if (view.size_ > (size - index) / 4) {
+      throw std::runtime_error("Truncated BigInteger record");
+    }
+    view.limbs_ = bytes + index;
+    index += 4 * view.size_;
+    if (view.size_ == 0 || view.Limb(view.size_ - 1) == 0) {
+      throw std::runtime_error("Malformed BigInteger record");
+    }
+  }
+  view.sign_ = (view.size_ == 0) ? 0 : sign;
+  if (consumed != nullptr) {
+    *consumed = index;
+  }
+  return view;
+}
+
+BigIntegerView BigIntegerView::FromLimbs(int sign, const char* limbs,
+                                         size_t size) {
+  BigIntegerView view;
+  view.sign_ = (size == 0) ? 0 : sign;
+  view.size_ = size;
+  view.limbs_ = reinterpret_cast<const unsigned char*>(limbs);
+  return view;
+}
+
+int BigIntegerView::Sign() const {
+  return sign_;
+}
+
+size_t BigIntegerView::Size() const {
+  return size_;
+}
+
+uint32_t BigIntegerView::Limb(size_t index) const {
+  if (limbs_ == nullptr) {
+    return static_cast<uint32_t>(small_ >> (32 * index));
+  }
+  const unsigned char* limb = limbs_ + 4 * index;
+  return static_cast<uint32_t>(limb[0]) |
+      (static_cast<uint32_t>(limb[1]) << 8) |
+      (static_cast<uint32_t>(limb[2]) << 16) |
+      (static_cast<uint32_t>(limb[3]) << 24);
+}
+
+BigInteger BigIntegerView::ToBigInteger() const {
+  BigInteger result;
+  result.sign_ = sign_;
+  result.digits_.resize(size_);
+  for (size_t i = 0; i < size_; ++i) {
+    result.digits_[i] = Limb(i);
+  }
+  return result;
+}
+
+std::string BigIntegerView::ToString(int base) const {
+  return ToBigInteger().ToString(base);
+}
+
+int BigIntegerView::Compare(const BigIntegerView& rhs) const {
+  if (sign_ != rhs.sign_) {
+    return (sign_ < rhs.sign_) ? -1 : 1;
+  }
+  if (size_ != rhs.size_) {
+    return (size_ < rhs.size_) ? -sign_ : sign_;
+  }
+  for (size_t i = size_; i-- > 0;) {
+    uint32_t lhs_limb = Limb(i);
+    uint32_t rhs_limb = rhs.Limb(i);
+    if (lhs_limb != rhs_limb) {
+      return (lhs_limb < rhs_limb) ? -sign_ : sign_;
+    }
+  }
+  return 0;
+}
+
+int BigIntegerView::Compare(const BigInteger& rhs) const {
+  if (sign_ != rhs.sign_) {
+    return (sign_ < rhs.sign_) ? -1 : 1;
+  }
+  if (size_ != rhs.digits_.size()) {
+    return (size_ < rhs.digits_.size()) ? -sign_ : sign_;
+  }
+  for (size_t i = size_; i-- > 0;) {
+    uint32_t lhs_limb = Limb(i);
+    if (lhs_limb != rhs.digits_[i]) {
+      return (lhs_limb < rhs.digits_[i]) ? -sign_ : sign_;
+    }
+  }
+  return 0;
+}
+
+void BigIntegerView::AddTo(BigInteger& big_int) const {
+  if (sign_ == 0) {
+    return;
+  }
+  std::vector<uint32_t>& digits = big_int.digits_;
+  if (big_int.sign_ == 0 || big_int.sign_ == sign_) {
+    big_int.sign_ = sign_;
+    if (digits.size() < size_) {
+      digits.resize(size_, 0);
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < digits.size() && (i < size_ || carry); ++i) {
+      carry += uint64_t{digits[i]} + ((i < size_) ? Limb(i) : 0);
+      digits[i] = static_cast<uint32_t>(carry);
+      carry >>= 32;
+    }
+    if (carry) {
+      digits.push_back(static_cast<uint32_t>(carry));
+    }
+    return;
+  }
+
+  // The signs differ: subtract the smaller magnitude from the larger one,
+  // the result takes the sign of the larger one.
+  BigIntegerView magnitude = *this;
+  magnitude.sign_ = big_int.sign_;
+  int order = magnitude.Compare(big_int) * big_int.sign_;
+  if (order == 0) {
+    big_int = BigInteger();
+    return;
+  }
+  bool view_is_larger = order > 0;
+  if (view_is_larger) {
+    digits.resize(size_, 0);
+    big_int.sign_ = sign_;
+  }
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < digits.size() && (i < size_ || borrow); ++i) {
+    uint64_t lhs_limb = view_is_larger ? Limb(i) : digits[i];
+    uint64_t rhs_limb = (view_is_larger ? digits[i] :
+                         (i < size_) ? Limb(i) : 0) + borrow;
+    borrow = (lhs_limb < rhs_limb) ? 1 : 0;
+    digits[i] = static_cast<uint32_t>(lhs_limb + (borrow << 32) - rhs_limb);
+  }
+  big_int.CleanLeadZeroes();
+}
+
+bool BigIntegerView::operator==(const BigIntegerView& rhs) const {
+  return Compare(rhs) == 0;
+}
+
+bool BigIntegerView::operator!=(const BigIntegerView& rhs) const {
+  return Compare(rhs) != 0;
+}
+
+bool BigIntegerView::operator<(const BigIntegerView& rhs) const {
+  return Compare(rhs) < 0;
+}
+
+bool BigIntegerView::operator<=(const BigIntegerView& rhs) const {
+  return Compare(rhs) <= 0;
+}
+
+bool BigIntegerView::operator>(const BigIntegerView& rhs) const {
+  return Compare(rhs) > 0;
+}
+
+bool BigIntegerView::operator>=(const BigIntegerView& rhs) const {
+  return Compare(rhs) >= 0;
+}
+
+}  // namespace big_num_arithmetic
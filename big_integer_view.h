@@ -0,0 +1,76 @@
+#ifndef BIG_INTEGER_VIEW_H_
+#define BIG_INTEGER_VIEW_H_
+
+#include "big_integer.h"
+#include <string>
+
+namespace big_num_arithmetic {
+
+// BINARY FORMAT
+// Every number starts with a header written as a varint (7 bits per byte,
+// the lowest group first, the high bit marks a continuation):
+//  * (magnitude << 2) | (negative << 1) | 0 for |value| < 2^62, so small
+//    numbers take from 1 to 9 bytes and have nothing after the header;
+//  * (size << 2) | (negative << 1) | 1 for the rest, followed by |size|
+//    digits of BigInteger, 4 little-endian bytes each, the lowest first.
+
+// Appends the binary form of the number to the end of the buffer.
+void AppendBinary(const BigInteger&, std::string&);
+
+// Returns the number of bytes AppendBinary() would append.
+size_t BinarySize(const BigInteger&);
+
+// Reads the number written by AppendBinary() from the beginning of data.
+BigInteger FromBinary(const std::string&);
+
+// Non-owning view of a number in the binary format. It points straight into
+// the buffer (e.g. a memory-mapped file), so the buffer must outlive it.
+// Nothing is copied until ToBigInteger() is called.
+class BigIntegerView {
+ public:
+  BigIntegerView() = default;
+
+  // Parses one number from [data, data + size). The number of bytes it
+  // occupies is stored to |consumed|, so that records can be read one by
+  // one. Throws std::runtime_error on truncated or malformed input.
+  static BigIntegerView Read(const char* data, size_t size,
+                             size_t* consumed = nullptr);
+
+  // View of |size| digits lying at |limbs| in the same 4-byte little-endian
+  // form as in records; the highest digit must be non-zero.
+  static BigIntegerView FromLimbs(int sign, const char* limbs, size_t size);
+
+  int Sign() const;
+  // Number of digits of BigInteger::internal_base, zero has no digits.
+  size_t Size() const;
+  uint32_t Limb(size_t) const;
+
+  BigInteger ToBigInteger() const;
+  std::string ToString(int) const;
+
+  // Returns -1, 0 or 1 like the comparison of the numbers themselves.
+  int Compare(const BigIntegerView&) const;
+  int Compare(const BigInteger&) const;
+
+  // Adds the number to |big_int| in place, without materializing it.
+  void AddTo(BigInteger& big_int) const;
+
+  bool operator==(const BigIntegerView&) const;
+  bool operator!=(const BigIntegerView&) const;
+  bool operator<(const BigIntegerView&) const;
+  bool operator<=(const BigIntegerView&) const;
+  bool operator>(const BigIntegerView&) const;
+  bool operator>=(const BigIntegerView&) const;
+
+ private:
+  int sign_{0};
+  size_t size_{0};
+  // Digits in the buffer, or nullptr if the number was small enough to be
+  // stored inside the header; then it is kept in small_.
+  const unsigned char* limbs_{nullptr};
+  uint64_t small_{0};
+};
+
+}  // namespace big_num_arithmetic
+
+#endif  // BIG_INTEGER_VIEW_H_
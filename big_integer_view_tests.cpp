@@ -0,0 +1,83 @@
+#include "big_integer_view.h"
+#include <gtest/gtest.h>
+
+namespace big_num_arithmetic {
+
+TEST(Test_16, BinaryRoundTrip) {
+  std::vector<BigInteger> values = {
+      BigInteger(0), BigInteger(1), BigInteger(-1), BigInteger(127),
+      BigInteger(INT64_MAX), BigInteger(INT64_MIN),
+      BigInteger::FromString("4611686018427387903", 10),
+      BigInteger::FromString("4611686018427387904", 10),
+      BigInteger::FromString("-123456789012345678901234567890", 10)};
+  std::string buffer;
+  for (const BigInteger& value : values) {
+    size_t old_size = buffer.size();
+    AppendBinary(value, buffer);
+    EXPECT_EQ(buffer.size() - old_size, BinarySize(value));
+  }
+  EXPECT_EQ(BinarySize(BigInteger(0)), 1u);
+  EXPECT_EQ(BinarySize(BigInteger(-31)), 1u);
+
+  size_t offset = 0;
+  for (const BigInteger& value : values) {
+    size_t consumed = 0;
+    BigIntegerView view = BigIntegerView::Read(
+        buffer.data() + offset, buffer.size() - offset, &consumed);
+    offset += consumed;
+    EXPECT_TRUE(view.ToBigInteger() == value);
+    EXPECT_EQ(view.ToString(10), value.ToString(10));
+    EXPECT_EQ(view.Sign(), value.Sign());
+    EXPECT_EQ(view.Compare(value), 0);
+  }
+  EXPECT_EQ(offset, buffer.size());
+  EXPECT_TRUE(FromBinary(buffer) == values.at(0));
+}
+
+TEST(Test_17, BinaryErrors) {
+  std::string buffer;
+  AppendBinary(BigInteger::FromString("123456789012345678901234567890", 10),
+               buffer);
+  EXPECT_THROW(BigIntegerView::Read(buffer.data(), buffer.size() - 1),
+               std::runtime_error);
+  EXPECT_THROW(BigIntegerView::Read(buffer.data(), 0), std::runtime_error);
+  std::string endless(11, '\xff');
+  EXPECT_THROW(BigIntegerView::Read(endless.data(), endless.size()),
+               std::runtime_error);
+  // Ten bytes with a bit above 2^63.
+  std::string too_long(9, '\x80');
+  too_long.push_back('\x02');
+  EXPECT_THROW(BigIntegerView::Read(too_long.data(), too_long.size()),
+               std::runtime_error);
+}
+
+TEST(Test_18, ViewComparingAndAdding) {
+  std::vector<std::string> numbers = {
+      "0", "5", "-5", "4294967296", "-4294967295",
+      "98765432109876543210987654321", "-98765432109876543210987654321",
+      "98765432109876543210987654322", "18446744073709551616"};
+  std::vector<std::string> buffers(numbers.size());
+  for (size_t i = 0; i < numbers.size(); ++i) {
+    AppendBinary(BigInteger::FromString(numbers[i], 10), buffers[i]);
+  }
+  for (size_t i = 0; i < numbers.size(); ++i) {
+    BigInteger lhs = BigInteger::FromString(numbers[i], 10);
+    BigIntegerView lhs_view =
+        BigIntegerView::Read(buffers[i].data(), buffers[i].size());
+    for (size_t j = 0; j < numbers.size(); ++j) {
+      BigInteger rhs = BigInteger::FromString(numbers[j], 10);
+      BigIntegerView rhs_view =
+          BigIntegerView::Read(buffers[j].data(), buffers[j].size());
+      EXPECT_EQ(lhs_view < rhs_view, lhs < rhs);
+      EXPECT_EQ(lhs_view == rhs_view, lhs == rhs);
+      EXPECT_EQ(lhs_view >= rhs_view, lhs >= rhs);
+      EXPECT_EQ(lhs_view.Compare(rhs) > 0, lhs > rhs);
+
+      BigInteger sum = rhs;
+      lhs_view.AddTo(sum);
+      EXPECT_TRUE(sum == lhs + rhs);
+    }
+  }
+}
+
+}  // namespace big_num_arithmetic
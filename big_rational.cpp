@@ -0,0 +1,307 @@
+#include "big_rational.h"
+#include <algorithm>
+#include <utility>
+
+namespace big_num_arithmetic {
+
+BigRational::BigRational() = default;
+
+BigRational::BigRational(BigInteger value) : numerator_(std::move(value)) {}
+
+BigRational::BigRational(BigInteger numerator, BigInteger denominator,
+                         Normalization normalization, size_t threshold)
+    : numerator_(std::move(numerator)),
+      denominator_(std::move(denominator)),
+      reduced_(false),
+      limit_(threshold),
+      normalization_(normalization),
+      threshold_(threshold) {
+  if (denominator_.Sign() == 0) {
+    throw DivisionByZeroError{};
+  }
+  if (denominator_.Sign() < 0) {
+    numerator_.Negate();
+    denominator_.Negate();
+  }
+  Normalize();
+}
+
+void BigRational::SetNormalization(Normalization normalization,
+                                   size_t threshold) {
+  normalization_ = normalization;
+  threshold_ = threshold;
+  limit_ = std::max(threshold_, reduced_ ? 2 * Size() : 0);
+  Normalize();
+}
+
+BigRational::Normalization BigRational::GetNormalization() const {
+  return normalization_;
+}
+
+// REDUCTION
+
+size_t BigRational::Size() const {
+  return numerator_.Limbs().size() + denominator_.Limbs().size();
+}
+
+void BigRational::Reduce() const {
+  if (reduced_) {
+    return;
+  }
+  BigInteger gcd = BigInteger::Gcd(numerator_, denominator_);
+  if (gcd != 1) {
+    numerator_ = BigInteger::DivExact(numerator_, gcd);
+    denominator_ = BigInteger::DivExact(denominator_, gcd);
+  }
+  reduced_ = true;
+  limit_ = std::max(threshold_, 2 * Size());
+}
+
+void BigRational::Normalize() {
+  if (denominator_ == 1) {
+    reduced_ = true;
+  }
+  switch (normalization_) {
+    case Normalization::kEager:
+      Reduce();
+      break;
+    case Normalization::kLazy:
+      break;
+    case Normalization::kBySize:
+      if (Size() > limit_) {
+        Reduce();
+      }
+      break;
+  }
+}
+
+bool BigRational::IsReduced() const {
+  return reduced_;
+}
+
+const BigInteger& BigRational::Numerator() const {
+  Reduce();
+  return numerator_;
+}
+
+const BigInteger& BigRational::Denominator() const {
+  Reduce();
+  return denominator_;
+}
+
+int BigRational::Sign() const {
+  return numerator_.Sign();
+}
+
+BigInteger BigRational::Floor() const {
+  BigInteger quotient = numerator_ / denominator_;
+  if (numerator_.Sign() < 0 && quotient * denominator_ != numerator_) {
+    quotient -= 1;
+  }
+  return quotient;
+}
+
+// STRING PROCESSING
+
+std::string BigRational::ToString(int base) const {
+  Reduce();
+  if (denominator_ == 1) {
+    return numerator_.ToString(base);
+  }
+  return numerator_.ToString(base) + "/" + denominator_.ToString(base);
+}
+
+std::ostream& operator<<(std::ostream& output, const BigRational& value) {
+  value.Reduce();
+  output << value.numerator_;
+  if (value.denominator_ != 1) {
+    output << '/' << value.denominator_;
+  }
+  return output;
+}
+
+// COMPARING
+
+bool BigRational::operator==(const BigRational& rhs) const {
+  if (numerator_.Sign() != rhs.numerator_.Sign()) {
+    return false;
+  }
+  if ((reduced_ && rhs.reduced_) || denominator_ == rhs.denominator_) {
+    return numerator_ == rhs.numerator_ && denominator_ == rhs.denominator_;
+  }
+  return numerator_ * rhs.denominator_ == rhs.numerator_ * denominator_;
+}
+
+std::strong_ordering BigRational::operator<=>(const BigRational& rhs) const {
+  int sign = numerator_.Sign();
+  if (sign != rhs.numerator_.Sign()) {
+    return sign <=> rhs.numerator_.Sign();
+  }
+  if (sign == 0) {
+    return std::strong_ordering::equal;
+  }
+  if (denominator_ == rhs.denominator_) {
+    return numerator_ <=> rhs.numerator_;
+  }
+  // A product of numbers of p and q bits has p + q or p + q - 1 bits, so
+  // the cross products differ in magnitude if their bit counts differ by
+  // two or more.
+  uint64_t lhs_bits = numerator_.BitLength() + rhs.denominator_.BitLength();
+  uint64_t rhs_bits = rhs.numerator_.BitLength() + denominator_.BitLength();
+  if (lhs_bits > rhs_bits + 1) {
+    return (sign > 0) ? std::strong_ordering::greater
+                      : std::strong_ordering::less;
+  }
+  if (rhs_bits > lhs_bits + 1) {
+    return (sign > 0) ? std::strong_ordering::less
+                      : std::strong_ordering::greater;
+  }
+  return numerator_ * rhs.denominator_ <=> rhs.numerator_ * denominator_;
+}
+
+// OPERATIONS
+
+void BigRational::AddReduced(const BigRational& rhs, bool subtract) {
+  // a/b + c/d with d1 = gcd(b, d): t = a (d/d1) + c (b/d1) and
+  // d2 = gcd(t, d1) give the reduced (t/d2) / ((b/d1) (d/d2)).
+  BigInteger rhs_numerator = subtract ? -rhs.numerator_ : rhs.numerator_;
+  BigInteger gcd = BigInteger::Gcd(denominator_, rhs.denominator_);
+  if (gcd == 1) {
+    BigInteger numerator = numerator_ * rhs.denominator_ +
+        rhs_numerator * denominator_;
+    denominator_ *= rhs.denominator_;
+    numerator_ = std::move(numerator);
+    return;
+  }
+  BigInteger lhs_part = BigInteger::DivExact(denominator_, gcd);
+  BigInteger sum = numerator_ * BigInteger::DivExact(rhs.denominator_, gcd) +
+      rhs_numerator * lhs_part;
+  if (sum.Sign() == 0) {
+    numerator_ = BigInteger();
+    denominator_ = BigInteger(1);
+    return;
+  }
+  BigInteger sum_gcd = BigInteger::Gcd(sum, gcd);
+  BigInteger denominator = lhs_part *
+      BigInteger::DivExact(rhs.denominator_, sum_gcd);
+  numerator_ = BigInteger::DivExact(sum, sum_gcd);
+  denominator_ = std::move(denominator);
+}
+
+void BigRational::MultiplyReduced(const BigRational& rhs) {
+  // (a/b) (c/d) = ((a/g1) (c/g2)) / ((b/g2) (d/g1)) with g1 = gcd(a, d)
+  // and g2 = gcd(c, b).
+  if (numerator_.Sign() == 0 || rhs.numerator_.Sign() == 0) {
+    numerator_ = BigInteger();
+    denominator_ = BigInteger(1);
+    return;
+  }
+  BigInteger lhs_gcd = BigInteger::Gcd(numerator_, rhs.denominator_);
+  BigInteger rhs_gcd = BigInteger::Gcd(rhs.numerator_, denominator_);
+  BigInteger numerator = BigInteger::DivExact(numerator_, lhs_gcd) *
+      BigInteger::DivExact(rhs.numerator_, rhs_gcd);
+  BigInteger denominator = BigInteger::DivExact(denominator_, rhs_gcd) *
+      BigInteger::DivExact(rhs.denominator_, lhs_gcd);
+  numerator_ = std::move(numerator);
+  denominator_ = std::move(denominator);
+}
+
+void BigRational::Add(const BigRational& rhs, bool subtract) {
+  if (&rhs == this) {
+    BigRational copy = rhs;
+    Add(copy, subtract);
+    return;
+  }
+  if (normalization_ == Normalization::kEager && reduced_ && rhs.reduced_) {
+    AddReduced(rhs, subtract);
+    return;
+  }
+  if (denominator_ == rhs.denominator_) {
+    if (subtract) {
+      numerator_ -= rhs.numerator_;
+    } else {
+      numerator_ += rhs.numerator_;
+    }
+  } else {
+    BigInteger rhs_part = rhs.numerator_ * denominator_;
+    numerator_ *= rhs.denominator_;
+    if (subtract) {
+      numerator_ -= rhs_part;
+    } else {
+      numerator_ += rhs_part;
+    }
+    denominator_ *= rhs.denominator_;
+  }
+  reduced_ = false;
+  Normalize();
+}
+
+void BigRational::operator+=(const BigRational& rhs) {
+  Add(rhs, false);
+}
+
+void BigRational::operator-=(const BigRational& rhs) {
+  Add(rhs, true);
+}
+
+void BigRational::operator*=(const BigRational& rhs) {
+  if (&rhs == this) {
+    BigRational copy = rhs;
+    *this *= copy;
+    return;
+  }
+  if (normalization_ == Normalization::kEager && reduced_ && rhs.reduced_) {
+    MultiplyReduced(rhs);
+    return;
+  }
+  numerator_ *= rhs.numerator_;
+  denominator_ *= rhs.denominator_;
+  reduced_ = false;
+  Normalize();
+}
+
+void BigRational::operator/=(const BigRational& rhs) {
+  if (rhs.numerator_.Sign() == 0) {
+    throw DivisionByZeroError{};
+  }
+  BigRational inverse;
+  inverse.numerator_ = rhs.denominator_;
+  inverse.denominator_ = rhs.numerator_.abs();
+  if (rhs.numerator_.Sign() < 0) {
+    inverse.numerator_.Negate();
+  }
+  inverse.reduced_ = rhs.reduced_;
+  *this *= inverse;
+}
+
+BigRational BigRational::operator-() const {
+  BigRational result = *this;
+  result.numerator_.Negate();
+  return result;
+}
+
+BigRational BigRational::operator+(const BigRational& rhs) const {
+  BigRational result = *this;
+  result += rhs;
+  return result;
+}
+
+BigRational BigRational::operator-(const BigRational& rhs) const {
+  BigRational result = *this;
+  result -= rhs;
+  return result;
+}
+
+BigRational BigRational::operator*(const BigRational& rhs) const {
+  BigRational result = *this;
+  result *= rhs;
+  return result;
+}
+
+BigRational BigRational::operator/(const BigRational& rhs) const {
+  BigRational result = *this;
+  result /= rhs;
+  return result;
+}
+
+}  // namespace big_num_arithmetic
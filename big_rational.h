@@ -0,0 +1,99 @@
+#ifndef BIG_RATIONAL_H_
+#define BIG_RATIONAL_H_
+
+#include "big_integer.h"
+#include <compare>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace big_num_arithmetic {
+
+// Exact fraction numerator / denominator with a positive denominator.
+// Reducing by the gcd costs more than the arithmetic itself, so when it
+// happens is chosen per value:
+//  - kEager keeps every result reduced, with the smaller gcds of Knuth
+//    (TAOCP 4.5.1) when both operands are reduced;
+//  - kLazy never reduces by itself, only Reduce(), Numerator(),
+//    Denominator() and ToString() do;
+//  - kBySize reduces once numerator and denominator together grow past
+//    a limit of digits; the limit of a value starts at the threshold and
+//    is twice the size of the last reduced value, so numbers that don't
+//    shrink are not reduced after every operation.
+// Results take the normalization of the left operand. Comparisons never
+// reduce: they compare signs and bit lengths first and multiply crosswise
+// only if those don't decide.
+//
+// The readers of the reduced form change the value in place, so one
+// object must not be used by several threads at the same time.
+class BigRational {
+ public:
+  enum class Normalization { kEager, kLazy, kBySize };
+
+  static constexpr size_t kDefaultThreshold = 32;
+
+  BigRational();
+  BigRational(BigInteger value);
+  // Throws DivisionByZeroError for a zero denominator.
+  BigRational(BigInteger numerator, BigInteger denominator,
+              Normalization = Normalization::kBySize,
+              size_t threshold = kDefaultThreshold);
+
+  // The threshold in digits is used by kBySize only.
+  void SetNormalization(Normalization,
+                        size_t threshold = kDefaultThreshold);
+  Normalization GetNormalization() const;
+
+  // The parts of the reduced fraction.
+  const BigInteger& Numerator() const;
+  const BigInteger& Denominator() const;
+  void Reduce() const;
+  bool IsReduced() const;
+  int Sign() const;
+  // The rounding of numerator / denominator towards minus infinity.
+  BigInteger Floor() const;
+
+  // "n/d" in lowest terms, or "n" for integers.
+  std::string ToString(int base = 10) const;
+  friend std::ostream& operator<<(std::ostream&, const BigRational&);
+
+  // COMPARING
+  bool operator==(const BigRational&) const;
+  std::strong_ordering operator<=>(const BigRational&) const;
+
+  // OPERATIONS
+  BigRational operator-() const;
+  BigRational operator+(const BigRational&) const;
+  BigRational operator-(const BigRational&) const;
+  BigRational operator*(const BigRational&) const;
+  // Throws DivisionByZeroError for a zero divisor.
+  BigRational operator/(const BigRational&) const;
+  void operator+=(const BigRational&);
+  void operator-=(const BigRational&);
+  void operator*=(const BigRational&);
+  void operator/=(const BigRational&);
+
+ private:
+  // Applies the normalization to a new result.
+  void Normalize();
+  // Digits of the numerator and the denominator together.
+  size_t Size() const;
+  // *this += RHS, or *this -= RHS if SUBTRACT is set.
+  void Add(const BigRational& rhs, bool subtract);
+  // The methods of Knuth for reduced operands, which keep the result
+  // reduced by gcds of the denominators instead of the whole result.
+  void AddReduced(const BigRational& rhs, bool subtract);
+  void MultiplyReduced(const BigRational& rhs);
+
+  mutable BigInteger numerator_;
+  mutable BigInteger denominator_{1};
+  mutable bool reduced_{true};
+  // Size in digits above which kBySize reduces.
+  mutable size_t limit_{kDefaultThreshold};
+  Normalization normalization_{Normalization::kBySize};
+  size_t threshold_{kDefaultThreshold};
+};
+
+}  // namespace big_num_arithmetic
+
+#endif  // BIG_RATIONAL_H_
@@ -0,0 +1,98 @@
+#include "big_rational.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <sstream>
+
+namespace big_num_arithmetic {
+
+TEST(Test_46, BigRationals) {
+  using Normalization = BigRational::Normalization;
+  EXPECT_THROW(BigRational(BigInteger(1), BigInteger(0)),
+               DivisionByZeroError);
+  EXPECT_THROW(BigRational(BigInteger(1)) / BigRational(), DivisionByZeroError);
+  {
+    BigRational value(BigInteger(6), BigInteger(-4), Normalization::kLazy);
+    EXPECT_FALSE(value.IsReduced());
+    EXPECT_EQ(value.Sign(), -1);
+    EXPECT_TRUE(value.Floor() == -2);
+    EXPECT_EQ(value.ToString(), "-3/2");
+    EXPECT_TRUE(value.IsReduced());
+    EXPECT_TRUE(value.Numerator() == -3 && value.Denominator() == 2);
+    EXPECT_EQ(BigRational(BigInteger(10), BigInteger(5)).ToString(), "2");
+    EXPECT_TRUE(BigRational(BigInteger(7), BigInteger(2)).Floor() == 3);
+    std::ostringstream output;
+    output << std::hex << BigRational(BigInteger(255), BigInteger(16));
+    EXPECT_EQ(output.str(), "ff/10");
+  }
+  {
+    // Equal fractions in other terms, and the comparisons decided by the
+    // bit lengths alone.
+    BigRational half(BigInteger(1), BigInteger(2));
+    BigRational also_half(BigInteger(37), BigInteger(74),
+                          Normalization::kLazy);
+    EXPECT_TRUE(half == also_half);
+    EXPECT_TRUE(half <= also_half && half >= also_half);
+    EXPECT_TRUE(BigRational(BigInteger(1) << 100, BigInteger(3)) >
+                BigRational(BigInteger(5), BigInteger(7)));
+    EXPECT_TRUE(BigRational(BigInteger(-1) << 100, BigInteger(3)) <
+                BigRational(BigInteger(-5), BigInteger(7)));
+    EXPECT_TRUE(BigRational(BigInteger(2), BigInteger(3)) <
+                BigRational(BigInteger(3), BigInteger(4)));
+    EXPECT_TRUE(BigRational(BigInteger(-1), BigInteger(3)) < BigRational());
+    EXPECT_TRUE(half - also_half == BigRational());
+  }
+  // Harmonic numbers: H_30 = 9304682830147 / 2329089562800.
+  for (Normalization normalization :
+       {Normalization::kEager, Normalization::kLazy,
+        Normalization::kBySize}) {
+    BigRational sum(BigInteger(0), BigInteger(1), normalization, 2);
+    for (int64_t k = 1; k <= 30; ++k) {
+      sum += BigRational(BigInteger(1), BigInteger(k));
+    }
+    EXPECT_EQ(sum.ToString(), "9304682830147/2329089562800");
+    if (normalization == Normalization::kEager) {
+      EXPECT_TRUE(sum.Denominator() == 2329089562800);
+    }
+  }
+  // The same random expressions in all the normalizations.
+  std::mt19937_64 rng(46);
+  for (int i = 0; i < 50; ++i) {
+    BigRational eager(BigInteger(1), BigInteger(1), Normalization::kEager);
+    BigRational lazy(BigInteger(1), BigInteger(1), Normalization::kLazy);
+    BigRational by_size(BigInteger(1), BigInteger(1),
+                        Normalization::kBySize, 4);
+    for (int step = 0; step < 30; ++step) {
+      BigInteger numerator = BigInteger::Random(1 + rng() % 80, rng) -
+          (BigInteger(1) << 40);
+      BigInteger denominator = BigInteger::Random(1 + rng() % 80, rng) + 1;
+      BigRational term(numerator, denominator, Normalization::kLazy);
+      uint64_t operation = rng() % 5;
+      for (BigRational* value : {&eager, &lazy, &by_size}) {
+        switch (operation) {
+          case 0:
+            *value += term;
+            break;
+          case 1:
+            *value -= term;
+            break;
+          case 2:
+            *value *= term;
+            break;
+          case 3:
+            if (term.Sign() != 0) {
+              *value /= term;
+            }
+            break;
+          default:
+            *value += *value;
+        }
+      }
+      EXPECT_TRUE(eager.IsReduced());
+      EXPECT_TRUE(eager == lazy && lazy == by_size);
+    }
+    EXPECT_EQ(eager.ToString(16), lazy.ToString(16));
+    EXPECT_EQ(eager.ToString(), by_size.ToString());
+  }
+}
+
+}  // namespace big_num_arithmetic
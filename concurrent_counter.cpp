@@ -0,0 +1,120 @@
+#include "concurrent_counter.h"
+#include <algorithm>
+
+namespace big_num_arithmetic {
+
+namespace {
+
+// Threads are numbered in the order of their first add to any counter, so
+// the first threads of a pool get different shards.
+size_t ThreadNumber() {
+  static std::atomic<size_t> next_number{0};
+  thread_local size_t number =
+      next_number.fetch_add(1, std::memory_order_relaxed);
+  return number;
+}
+
+}  // namespace
+
+ConcurrentCounter::ConcurrentCounter(size_t shards)
+    : shard_count_(std::max<size_t>(shards, 1)),
+      shards_(new Shard[shard_count_]) {}
+
+ConcurrentCounter::Shard& ConcurrentCounter::ShardOfThread() {
+  return shards_[ThreadNumber() % shard_count_];
+}
+
+void ConcurrentCounter::Spill(Shard& shard, const BigInteger& big_int) {
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  // Exchanging keeps the adds of other threads that share the shard: they
+  // either landed before and are moved, or they retry on zero.
+  int64_t partial = shard.partial.exchange(0, std::memory_order_relaxed);
+  shard.spilled += partial;
+  shard.spilled += big_int;
+}
+
+// OPERATIONS
+
+void ConcurrentCounter::Add(int64_t short_number) {
+  Shard& shard = ShardOfThread();
+  int64_t partial = shard.partial.load(std::memory_order_relaxed);
+  int64_t sum;
+  do {
+    if (__builtin_add_overflow(partial, short_number, &sum)) {
+      Spill(shard, BigInteger(short_number));
+      return;
+    }
+  } while (!shard.partial.compare_exchange_weak(partial, sum,
+                                                std::memory_order_relaxed));
+}
+
+void ConcurrentCounter::Add(const BigInteger& big_int) {
+  if (big_int.FitsInt64()) {
+    Add(big_int.ToInt64());
+    return;
+  }
+  Spill(ShardOfThread(), big_int);
+}
+
+void ConcurrentCounter::Subtract(int64_t short_number) {
+  if (short_number == INT64_MIN) {
+    // -INT64_MIN is not an int64_t.
+    Spill(ShardOfThread(), -BigInteger(short_number));
+    return;
+  }
+  Add(-short_number);
+}
+
+void ConcurrentCounter::Subtract(const BigInteger& big_int) {
+  if (big_int.FitsInt64()) {
+    Subtract(big_int.ToInt64());
+    return;
+  }
+  Spill(ShardOfThread(), -big_int);
+}
+
+void ConcurrentCounter::operator+=(int64_t short_number) {
+  Add(short_number);
+}
+
+void ConcurrentCounter::operator+=(const BigInteger& big_int) {
+  Add(big_int);
+}
+
+void ConcurrentCounter::operator-=(int64_t short_number) {
+  Subtract(short_number);
+}
+
+void ConcurrentCounter::operator-=(const BigInteger& big_int) {
+  Subtract(big_int);
+}
+
+// MERGING
+
+BigInteger ConcurrentCounter::Value() const {
+  BigInteger result;
+  for (size_t i = 0; i < shard_count_; ++i) {
+    const Shard& shard = shards_[i];
+    // Under the lock the partial sum is not being moved, so a value is
+    // counted either in partial or in spilled.
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    result += shard.spilled;
+    result += shard.partial.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+void ConcurrentCounter::Reset() {
+  for (size_t i = 0; i < shard_count_; ++i) {
+    Shard& shard = shards_[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.partial.store(0, std::memory_order_relaxed);
+    shard.spilled = BigInteger();
+  }
+}
+
+size_t ConcurrentCounter::Shards() const {
+  return shard_count_;
+}
+
+}  // namespace big_num_arithmetic
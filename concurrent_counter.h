@@ -0,0 +1,65 @@
+#ifndef CONCURRENT_COUNTER_H_
+#define CONCURRENT_COUNTER_H_
+
+#include "big_integer.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace big_num_arithmetic {
+
+// Total that many threads change at once, without a lock shared by all of
+// them. Every thread is given one of the shards; a shard keeps a native
+// 64-bit partial sum, which takes the adds of int64_t values (and of
+// numbers that fit into one) with a single compare-and-swap. Only when the
+// partial sum would overflow, or for a longer number, the thread locks its
+// own shard and moves the sum into the BigInteger of the shard.
+//
+// Value() merges the shards. An add that runs at the same time as Value()
+// or Reset() is seen by it or not, but it is never lost or seen twice.
+class ConcurrentCounter {
+ public:
+  // With as many shards as threads, the threads don't share cache lines.
+  explicit ConcurrentCounter(
+      size_t shards = std::thread::hardware_concurrency());
+  ConcurrentCounter(const ConcurrentCounter&) = delete;
+  ConcurrentCounter& operator=(const ConcurrentCounter&) = delete;
+
+  void Add(int64_t);
+  void Add(const BigInteger&);
+  void Subtract(int64_t);
+  void Subtract(const BigInteger&);
+  void operator+=(int64_t);
+  void operator+=(const BigInteger&);
+  void operator-=(int64_t);
+  void operator-=(const BigInteger&);
+
+  BigInteger Value() const;
+  void Reset();
+
+  size_t Shards() const;
+
+ private:
+  // A cache line each, so the partial sums of different threads don't
+  // invalidate each other.
+  struct alignas(64) Shard {
+    std::atomic<int64_t> partial{0};
+    // Guards spilled and the moves of partial into it.
+    mutable std::mutex mutex;
+    BigInteger spilled;
+  };
+
+  Shard& ShardOfThread();
+  // The slow path: moves the partial sum of SHARD and BIG_INT into
+  // spilled.
+  static void Spill(Shard& shard, const BigInteger& big_int);
+
+  size_t shard_count_;
+  std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace big_num_arithmetic
+
+#endif  // CONCURRENT_COUNTER_H_
@@ -0,0 +1,60 @@
+#include "concurrent_counter.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace big_num_arithmetic {
+
+TEST(Test_43, ConcurrentCounter) {
+  {
+    ConcurrentCounter counter(0);
+    EXPECT_EQ(counter.Shards(), 1u);
+    EXPECT_TRUE(counter.Value() == 0);
+    counter.Add(INT64_MAX);
+    counter.Add(INT64_MAX);
+    counter.Subtract(INT64_MIN);
+    EXPECT_TRUE(counter.Value() == BigInteger(INT64_MAX) * 3 + 1);
+    counter -= BigInteger(1) << 100;
+    counter += 5;
+    EXPECT_TRUE(counter.Value() ==
+                BigInteger(INT64_MAX) * 3 + 6 - (BigInteger(1) << 100));
+    counter.Reset();
+    EXPECT_TRUE(counter.Value() == 0);
+    counter -= 7;
+    EXPECT_TRUE(counter.Value() == -7);
+  }
+  // Threads sharing one shard and threads with shards of their own; the
+  // terms near INT64_MAX make the partial sums spill all the time.
+  for (size_t shards : {size_t{1}, size_t{8}}) {
+    ConcurrentCounter counter(shards);
+    const int kThreads = 8;
+    const int kTerms = 20000;
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < kThreads; ++thread) {
+      threads.emplace_back([&counter, thread] {
+        BigInteger big_term = BigInteger(thread + 1) << 70;
+        for (int i = 0; i < kTerms; ++i) {
+          counter.Add(INT64_MAX - i);
+          counter -= thread;
+          if (i % 100 == 0) {
+            counter += big_term;
+            // Reading at the same time must not break the adds.
+            counter.Value();
+          }
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    BigInteger expected;
+    for (int thread = 0; thread < kThreads; ++thread) {
+      expected += (BigInteger(INT64_MAX) * kTerms
+          - int64_t{kTerms} * (kTerms - 1) / 2 - int64_t{thread} * kTerms
+          + (BigInteger(thread + 1) << 70) * (kTerms / 100));
+    }
+    EXPECT_TRUE(counter.Value() == expected);
+  }
+}
+
+}  // namespace big_num_arithmetic
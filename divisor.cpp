@@ -0,0 +1,177 @@
+#include "divisor.h"
+#include "instrumentation.h"
+#include "limb_kernels.h"
+#include <algorithm>
+#include <bit>
+
+namespace big_num_arithmetic {
+
+namespace {
+
+// VALUE div B^count for the magnitude of VALUE.
+BigInteger HighDigits(const BigInteger& value, size_t count) {
+  const std::vector<uint32_t>& digits = value.Limbs();
+  if (digits.size() <= count) {
+    return BigInteger();
+  }
+  return BigInteger::FromLimbs(digits.data() + count, digits.size() - count);
+}
+
+// HIGH * B^count + the digits [from, from + count) of the magnitude of
+// VALUE, in one allocation.
+BigInteger Append(const BigInteger& high, const BigInteger& value,
+                  size_t from, size_t count) {
+  const std::vector<uint32_t>& value_digits = value.Limbs();
+  std::vector<uint32_t> digits(count + high.Limbs().size(), 0);
+  size_t end = std::min(from + count, value_digits.size());
+  if (from < end) {
+    std::copy(value_digits.begin() + from, value_digits.begin() + end,
+              digits.begin());
+  }
+  std::copy(high.Limbs().begin(), high.Limbs().end(),
+            digits.begin() + count);
+  return BigInteger::FromLimbs(digits.data(), digits.size());
+}
+
+}  // namespace
+
+Divisor::Divisor(const BigInteger& divisor)
+    : divisor_(divisor), shift_(0), reciprocal_(0) {
+  if (divisor.Sign() == 0) {
+    throw DivisionByZeroError{};
+  }
+  shift_ = std::countl_zero(divisor.Limbs().back());
+  normalized_ = divisor.abs() << shift_;
+  reciprocal_ = kernels::Reciprocal(normalized_.Limbs().back());
+  size_t size = normalized_.Limbs().size();
+  if (size >= kBarrettThreshold) {
+    inverse_ = (BigInteger(1) << (64 * size)) / normalized_;
+  }
+}
+
+const BigInteger& Divisor::Value() const {
+  return divisor_;
+}
+
+// DIVISION
+
+void Divisor::SchoolbookDivide(const BigInteger& numerator,
+                               BigInteger& quotient,
+                               BigInteger& remainder) const {
+  const std::vector<uint32_t>& divisor_digits = normalized_.Limbs();
+  size_t divisor_size = divisor_digits.size();
+  size_t size = numerator.Limbs().size();
+  BIG_INTEGER_COUNT(kDivide, size + divisor_size, 2);
+  // The shifted numerator and a zero digit on top, as the kernel needs.
+  std::vector<uint32_t> digits(size + 2, 0);
+  digits[size] = kernels::ShiftLeft(numerator.Limbs().data(), size, shift_,
+                                    digits.data());
+  std::vector<uint32_t> quotient_digits(digits.size() - divisor_size);
+  kernels::SchoolbookDivide(digits.data(), digits.size(),
+                            divisor_digits.data(), divisor_size, reciprocal_,
+                            quotient_digits.data());
+  quotient = BigInteger::FromLimbs(quotient_digits.data(),
+                                   quotient_digits.size());
+  kernels::ShiftRight(digits.data(), divisor_size, shift_, digits.data());
+  remainder = BigInteger::FromLimbs(digits.data(), divisor_size);
+}
+
+void Divisor::BarrettDivide(const BigInteger& numerator,
+                            BigInteger& quotient,
+                            BigInteger& remainder) const {
+  // Long division by blocks of n digits, as in operator/; the remainder
+  // stays below the divisor, so every window is below B^(2 n) and its
+  // quotient q_b has n digits. Algorithm 14.42 of the Handbook of Applied
+  // Cryptography estimates q_b by two products, at most 2 too small.
+  size_t divisor_size = normalized_.Limbs().size();
+  BigInteger shifted = numerator.abs() << shift_;
+  size_t blocks = (shifted.Limbs().size() + divisor_size - 1) / divisor_size;
+  BIG_INTEGER_COUNT(kDivide, shifted.Limbs().size() + divisor_size,
+                    4 * blocks + 2);
+  std::vector<uint32_t> quotient_digits(blocks * divisor_size, 0);
+  BigInteger rest;
+  for (size_t block = blocks; block-- > 0;) {
+    BigInteger current = Append(rest, shifted, block * divisor_size,
+                                divisor_size);
+    BigInteger block_quotient = HighDigits(
+        HighDigits(current, divisor_size - 1) * inverse_, divisor_size + 1);
+    rest = current - block_quotient * normalized_;
+    while (rest >= normalized_) {
+      rest -= normalized_;
+      block_quotient += 1;
+    }
+    std::copy(block_quotient.Limbs().begin(), block_quotient.Limbs().end(),
+              quotient_digits.begin() + block * divisor_size);
+  }
+  quotient = BigInteger::FromLimbs(quotient_digits.data(),
+                                   quotient_digits.size());
+  remainder = rest >> shift_;
+}
+
+void Divisor::DivideMagnitude(const BigInteger& numerator,
+                              BigInteger& quotient,
+                              BigInteger& remainder) const {
+  const std::vector<uint32_t>& digits = numerator.Limbs();
+  size_t divisor_size = normalized_.Limbs().size();
+  if (digits.size() < divisor_size) {
+    quotient = BigInteger();
+    remainder = numerator.abs();
+    return;
+  }
+  if (divisor_size == 1) {
+    // The hardware division is as fast as the reciprocal in a chain of
+    // dependent digits.
+    uint64_t divisor = divisor_.Limbs()[0];
+    std::vector<uint32_t> quotient_digits(digits.size());
+    uint64_t rest = 0;
+    for (size_t i = digits.size(); i-- > 0;) {
+      uint64_t current_digit = (rest << 32) | digits[i];
+      quotient_digits[i] = static_cast<uint32_t>(current_digit / divisor);
+      rest = current_digit % divisor;
+    }
+    quotient = BigInteger::FromLimbs(quotient_digits.data(),
+                                     quotient_digits.size());
+    remainder = BigInteger(rest);
+    return;
+  }
+  if (inverse_.Sign() == 0) {
+    SchoolbookDivide(numerator, quotient, remainder);
+  } else {
+    BarrettDivide(numerator, quotient, remainder);
+  }
+}
+
+void Divisor::DivMod(const BigInteger& numerator, BigInteger& quotient,
+                     BigInteger& remainder) const {
+  DivideMagnitude(numerator, quotient, remainder);
+  if (numerator.Sign() * divisor_.Sign() < 0) {
+    quotient.Negate();
+  }
+  if (numerator.Sign() < 0) {
+    remainder.Negate();
+  }
+}
+
+BigInteger Divisor::Divide(const BigInteger& numerator) const {
+  BigInteger quotient;
+  BigInteger remainder;
+  DivMod(numerator, quotient, remainder);
+  return quotient;
+}
+
+BigInteger Divisor::Remainder(const BigInteger& numerator) const {
+  BigInteger quotient;
+  BigInteger remainder;
+  DivMod(numerator, quotient, remainder);
+  return remainder;
+}
+
+BigInteger operator/(const BigInteger& numerator, const Divisor& divisor) {
+  return divisor.Divide(numerator);
+}
+
+BigInteger operator%(const BigInteger& numerator, const Divisor& divisor) {
+  return divisor.Remainder(numerator);
+}
+
+}  // namespace big_num_arithmetic
@@ -0,0 +1,60 @@
+#ifndef DIVISOR_H_
+#define DIVISOR_H_
+
+#include "big_integer.h"
+#include <vector>
+
+namespace big_num_arithmetic {
+
+// A divisor fixed in advance, for many quotients by the same number. The
+// constructor does everything that depends on the divisor alone: it
+// shifts the divisor so that its highest bit is set and computes the
+// reciprocal used for the quotient digits, so every division skips that
+// setup. Divisors of one digit divide by the hardware division, those of
+// up to kBarrettThreshold digits by the schoolbook method with the
+// reciprocal of the highest digit, and longer ones by Barrett's method
+// with floor(B^(2 n) / d) for n digits: two products per block of n
+// digits of the quotient.
+//
+// Quotients round towards zero, as operator/ of BigInteger does, and
+// remainders have the sign of the numerator.
+class Divisor {
+ public:
+  static constexpr size_t kBarrettThreshold = 64;
+
+  // Throws DivisionByZeroError for zero.
+  explicit Divisor(const BigInteger& divisor);
+
+  const BigInteger& Value() const;
+
+  BigInteger Divide(const BigInteger& numerator) const;
+  BigInteger Remainder(const BigInteger& numerator) const;
+  void DivMod(const BigInteger& numerator, BigInteger& quotient,
+              BigInteger& remainder) const;
+
+ private:
+  // Division of NUMERATOR >= 0 by |Value()|.
+  void DivideMagnitude(const BigInteger& numerator, BigInteger& quotient,
+                       BigInteger& remainder) const;
+  void SchoolbookDivide(const BigInteger& numerator, BigInteger& quotient,
+                        BigInteger& remainder) const;
+  void BarrettDivide(const BigInteger& numerator, BigInteger& quotient,
+                     BigInteger& remainder) const;
+
+  BigInteger divisor_;
+  // Number of leading zero bits of the highest digit of |divisor_|.
+  unsigned shift_;
+  // |divisor_| * 2^shift_.
+  BigInteger normalized_;
+  // kernels::Reciprocal() of the highest digit of normalized_.
+  uint32_t reciprocal_;
+  // floor(B^(2 n) / normalized_) for the Barrett method, zero otherwise.
+  BigInteger inverse_;
+};
+
+BigInteger operator/(const BigInteger&, const Divisor&);
+BigInteger operator%(const BigInteger&, const Divisor&);
+
+}  // namespace big_num_arithmetic
+
+#endif  // DIVISOR_H_
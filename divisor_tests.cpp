@@ -0,0 +1,64 @@
+#include "divisor.h"
+#include <gtest/gtest.h>
+#include <random>
+
+namespace big_num_arithmetic {
+
+TEST(Test_45, InvariantDivisor) {
+  EXPECT_THROW(Divisor(BigInteger(0)), DivisionByZeroError);
+  {
+    Divisor divisor(BigInteger(-7));
+    EXPECT_TRUE(divisor.Value() == -7);
+    EXPECT_TRUE(BigInteger(45) / divisor == -6);
+    EXPECT_TRUE(BigInteger(45) % divisor == 3);
+    EXPECT_TRUE(BigInteger(-45) / divisor == 6);
+    EXPECT_TRUE(BigInteger(-45) % divisor == -3);
+    EXPECT_TRUE(BigInteger(0) / divisor == 0);
+  }
+  {
+    // The highest digit of every window equals that of the divisor.
+    BigInteger all_ones = (BigInteger(1) << 96) - 1;
+    Divisor divisor(all_ones);
+    BigInteger numerator = (BigInteger(1) << 320) - 1;
+    EXPECT_TRUE(numerator / divisor == numerator / all_ones);
+    EXPECT_TRUE(numerator % divisor ==
+                numerator - numerator / all_ones * all_ones);
+  }
+  // The highest digits of the divisors are small, big and equal to those
+  // of the numerators, for all three methods of division.
+  std::mt19937_64 rng(45);
+  for (uint64_t bits : {1, 31, 32, 33, 64, 95, 500, 2047, 2048, 2049,
+                        2080, 4500}) {
+    BigInteger value = BigInteger::Random(bits, rng) |
+        (BigInteger(1) << (bits - 1));
+    if (bits % 2 == 1) {
+      value.Negate();
+    }
+    Divisor divisor(value);
+    for (int i = 0; i < 20; ++i) {
+      BigInteger numerator = BigInteger::Random(rng() % (3 * bits + 200),
+                                                rng);
+      if (i % 4 == 1) {
+        numerator.Negate();
+      }
+      if (i % 4 == 2) {
+        // All ones and a multiple of the divisor, the hardest cases of
+        // the digit estimates.
+        numerator = (BigInteger(1) << (2 * bits + 64)) - 1;
+      }
+      if (i % 4 == 3) {
+        numerator = value * BigInteger::Random(bits + 40, rng);
+      }
+      BigInteger quotient;
+      BigInteger remainder;
+      divisor.DivMod(numerator, quotient, remainder);
+      EXPECT_TRUE(quotient == numerator / value);
+      EXPECT_TRUE(quotient * value + remainder == numerator);
+      EXPECT_TRUE(remainder.abs() < value.abs());
+      EXPECT_TRUE(remainder.Sign() == 0 ||
+                  remainder.Sign() == numerator.Sign());
+    }
+  }
+}
+
+}  // namespace big_num_arithmetic
@@ -1,34 +1,806 @@
 ﻿#include "equation_solver.h"
+#include "divisor.h"
+#include "mod_context.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <optional>
 
 // using namespace big_num_arithmetic;
 
 namespace equation_solver {
 
-QuadraticEquation GenerateEquation(const big_num_arithmetic::BigInteger& a,
-                              const big_num_arithmetic::BigInteger& root_1,
-                              const big_num_arithmetic::BigInteger& root_2) {
+QuadraticEquation GenerateEquation(
+    const big_num_arithmetic::SharedBigInteger& a,
+    const big_num_arithmetic::BigInteger& root_1,
+    const big_num_arithmetic::BigInteger& root_2) {
   QuadraticEquation equation;
   equation.a = a;
-  equation.b = -a * (root_1 + root_2);
-  equation.c = a * root_1 * root_2;
+  equation.b = -a.Get() * (root_1 + root_2);
+  equation.c = a.Get() * root_1 * root_2;
   return equation;
 }
 
 bool Solve(const QuadraticEquation& equation,
            big_num_arithmetic::BigInteger& root_1,
            big_num_arithmetic::BigInteger& root_2) {
-  big_num_arithmetic::BigInteger
-  big_disc = equation.b * equation.b - 4 * equation.c * equation.a;
+  const big_num_arithmetic::BigInteger& a = equation.a;
+  const big_num_arithmetic::BigInteger& b = equation.b;
+  const big_num_arithmetic::BigInteger& c = equation.c;
+  big_num_arithmetic::BigInteger big_disc = b * b - 4 * c * a;
   if (big_disc < 0) {
     return false;
   }
-  root_1 = (-equation.b - helpers::Sqrt(big_disc)) / (equation.a * 2);
-  root_2 = (-equation.b + helpers::Sqrt(big_disc)) / (equation.a * 2);
+  // Both roots share the square root and the divisor.
+  big_num_arithmetic::BigInteger disc_root = helpers::Sqrt(big_disc);
+  big_num_arithmetic::Divisor divisor(a * 2);
+  root_1 = (-b - disc_root) / divisor;
+  root_2 = (-b + disc_root) / divisor;
   return true;
 }
 
+bool SolveRational(const QuadraticEquation& equation,
+                   big_num_arithmetic::BigRational& root_1,
+                   big_num_arithmetic::BigRational& root_2) {
+  const big_num_arithmetic::BigInteger& a = equation.a;
+  const big_num_arithmetic::BigInteger& b = equation.b;
+  const big_num_arithmetic::BigInteger& c = equation.c;
+  big_num_arithmetic::BigInteger big_disc = b * b - 4 * c * a;
+  if (big_disc < 0) {
+    return false;
+  }
+  big_num_arithmetic::BigInteger disc_root = helpers::Sqrt(big_disc);
+  if (disc_root * disc_root != big_disc) {
+    return false;
+  }
+  root_1 = big_num_arithmetic::BigRational(-b - disc_root, a * 2);
+  root_2 = big_num_arithmetic::BigRational(-b + disc_root, a * 2);
+  return true;
+}
+
+// POLYNOMIALS
+
+namespace {
+
+using Coefficients = std::vector<big_num_arithmetic::BigInteger>;
+
+// Parts of the split evaluation this short run Horner's scheme.
+const size_t kSplitLeaf = 16;
+// Trial division takes the factors below this bound.
+const uint32_t kTrialDivisionBound = 1024;
+// Steps of Pollard's rho whose differences share one gcd.
+const uint64_t kRhoBatch = 128;
+// The roots modulo a prime at least this big are lifted.
+const uint64_t kMinRootModulus = 64;
+// Candidate roots must give zero modulo these primes.
+constexpr std::array<uint32_t, 2> kFilterPrimes = {4294967291u, 4294967279u};
+
+// The coefficients without the zeros on top.
+Coefficients Trimmed(const PolynomialEquation& equation) {
+  Coefficients coefficients = equation.coefficients;
+  while (!coefficients.empty() && coefficients.back() == 0) {
+    coefficients.pop_back();
+  }
+  return coefficients;
+}
+
+// VALUE mod MODULUS in [0, MODULUS).
+uint64_t Residue(const big_num_arithmetic::BigInteger& value,
+                 uint32_t modulus) {
+  const std::vector<uint32_t>& digits = value.Limbs();
+  uint32_t remainder = big_num_arithmetic::kernels::RemainderByDigit(
+      digits.data(), digits.size(), modulus);
+  if (value.Sign() < 0 && remainder != 0) {
+    return modulus - remainder;
+  }
+  return remainder;
+}
+
+// EVALUATION
+
+// Horner's scheme for the values of COEFFICIENTS[BEGIN, END) at all the
+// points, one coefficient at a time. Points of one word multiply without
+// the conversion to BigInteger.
+Coefficients EvaluateHorner(const Coefficients& coefficients, size_t begin,
+                            size_t end, const Coefficients& points) {
+  std::vector<std::optional<int64_t>> short_points(points.size());
+  for (size_t j = 0; j < points.size(); ++j) {
+    short_points[j] = points[j].TryToInt64();
+  }
+  Coefficients values(points.size(), coefficients[end - 1]);
+  for (size_t i = end - 1; i-- > begin;) {
+    for (size_t j = 0; j < points.size(); ++j) {
+      if (short_points[j]) {
+        values[j] *= *short_points[j];
+      } else {
+        values[j] *= points[j];
+      }
+      values[j] += coefficients[i];
+    }
+  }
+  return values;
+}
+
+// The value of COEFFICIENTS[BEGIN, END) at x, with POWERS[k] = x^(2^k).
+big_num_arithmetic::BigInteger EvaluateSplit(
+    const Coefficients& coefficients, size_t begin, size_t end,
+    const Coefficients& point, const Coefficients& powers) {
+  if (end - begin <= kSplitLeaf) {
+    return EvaluateHorner(coefficients, begin, end, point)[0];
+  }
+  size_t half = std::bit_floor(end - begin - 1);
+  return EvaluateSplit(coefficients, begin, begin + half, point, powers) +
+         powers[std::countr_zero(half)] *
+             EvaluateSplit(coefficients, begin + half, end, point, powers);
+}
+
+Coefficients EvaluateTrimmed(const Coefficients& coefficients,
+                             const Coefficients& points) {
+  Coefficients values(points.size());
+  if (coefficients.empty()) {
+    return values;
+  }
+  Coefficients horner_points;
+  std::vector<size_t> horner_indices;
+  Coefficients powers;
+  for (size_t j = 0; j < points.size(); ++j) {
+    if (coefficients.size() < kSplitThreshold ||
+        points[j].Limbs().size() < kSplitDigits) {
+      horner_points.push_back(points[j]);
+      horner_indices.push_back(j);
+      continue;
+    }
+    powers.assign(1, points[j]);
+    while ((size_t{1} << powers.size()) < coefficients.size()) {
+      powers.push_back(powers.back() * powers.back());
+    }
+    values[j] = EvaluateSplit(coefficients, 0, coefficients.size(),
+                              Coefficients{points[j]}, powers);
+  }
+  if (!horner_points.empty()) {
+    Coefficients horner_values = EvaluateHorner(
+        coefficients, 0, coefficients.size(), horner_points);
+    for (size_t k = 0; k < horner_indices.size(); ++k) {
+      values[horner_indices[k]] = std::move(horner_values[k]);
+    }
+  }
+  return values;
+}
+
+// FACTORIZATION
+
+struct PrimePower {
+  big_num_arithmetic::BigInteger prime;
+  uint64_t exponent;
+};
+
+// A factor of the odd composite N other than 1 and N, by Brent's variant
+// of Pollard's rho: y -> y^2 + c modulo N, with the differences of a batch
+// of steps multiplied together so that they take one gcd.
+big_num_arithmetic::BigInteger RhoFactor(
+    const big_num_arithmetic::BigInteger& n) {
+  big_num_arithmetic::ModContext context(n);
+  for (int64_t c = 1;; ++c) {
+    big_num_arithmetic::BigInteger increment =
+        context.ToResidue(big_num_arithmetic::BigInteger(c));
+    auto step = [&](big_num_arithmetic::BigInteger& value) {
+      context.MulMod(value, value, value);
+      context.AddMod(value, increment, value);
+    };
+    big_num_arithmetic::BigInteger y =
+        context.ToResidue(big_num_arithmetic::BigInteger(2));
+    big_num_arithmetic::BigInteger product =
+        context.ToResidue(big_num_arithmetic::BigInteger(1));
+    big_num_arithmetic::BigInteger x;
+    big_num_arithmetic::BigInteger saved;
+    big_num_arithmetic::BigInteger difference;
+    big_num_arithmetic::BigInteger factor(1);
+    for (uint64_t length = 1; factor == 1; length *= 2) {
+      x = y;
+      for (uint64_t i = 0; i < length; ++i) {
+        step(y);
+      }
+      for (uint64_t done = 0; done < length && factor == 1;
+           done += kRhoBatch) {
+        saved = y;
+        for (uint64_t i = 0; i < std::min(kRhoBatch, length - done); ++i) {
+          step(y);
+          context.SubMod(x, y, difference);
+          context.MulMod(product, difference, product);
+        }
+        // Montgomery's residues are x R with R prime to N, which keeps the
+        // gcd.
+        factor = big_num_arithmetic::BigInteger::Gcd(product, n);
+      }
+    }
+    if (factor == n) {
+      // The batch went past the factor, its steps are taken one by one.
+      do {
+        step(saved);
+        context.SubMod(x, saved, difference);
+        factor = big_num_arithmetic::BigInteger::Gcd(difference, n);
+      } while (factor == 1);
+    }
+    if (factor != n) {
+      return factor;
+    }
+  }
+}
+
+// Adds the prime factors of N > 1, which has no factors below the trial
+// division bound, with their exponents times MULTIPLICITY.
+void AddFactors(const big_num_arithmetic::BigInteger& n,
+                uint64_t multiplicity, std::vector<PrimePower>& factors) {
+  big_num_arithmetic::BigInteger root;
+  uint64_t exponent;
+  if (n.IsProbablePrime()) {
+    factors.push_back({n, multiplicity});
+  } else if (big_num_arithmetic::BigInteger::IsPerfectPower(n, root,
+                                                            exponent)) {
+    AddFactors(root, multiplicity * exponent, factors);
+  } else {
+    big_num_arithmetic::BigInteger factor = RhoFactor(n);
+    AddFactors(factor, multiplicity, factors);
+    AddFactors(big_num_arithmetic::BigInteger::DivExact(n, factor),
+               multiplicity, factors);
+  }
+}
+
+// The prime factors of N > 0 in ascending order.
+std::vector<PrimePower> Factorize(big_num_arithmetic::BigInteger n) {
+  std::vector<PrimePower> factors;
+  for (uint32_t divisor = 2; divisor < kTrialDivisionBound; ++divisor) {
+    if (n < int64_t{divisor} * divisor) {
+      break;
+    }
+    uint64_t exponent = 0;
+    while (Residue(n, divisor) == 0) {
+      n /= int64_t{divisor};
+      ++exponent;
+    }
+    if (exponent != 0) {
+      factors.push_back({big_num_arithmetic::BigInteger(divisor), exponent});
+    }
+  }
+  if (n > 1) {
+    AddFactors(n, 1, factors);
+  }
+  std::sort(factors.begin(), factors.end(),
+            [](const PrimePower& lhs, const PrimePower& rhs) {
+              return lhs.prime < rhs.prime;
+            });
+  // Rho may split off the same prime twice.
+  std::vector<PrimePower> merged;
+  for (PrimePower& factor : factors) {
+    if (!merged.empty() && merged.back().prime == factor.prime) {
+      merged.back().exponent += factor.exponent;
+    } else {
+      merged.push_back(std::move(factor));
+    }
+  }
+  return merged;
+}
+
+// Appends the divisors of the factored number that are at most BOUND.
+// The primes ascend, so a power above the bound ends its loop.
+void EnumerateDivisors(const std::vector<PrimePower>& factors, size_t index,
+                       const big_num_arithmetic::BigInteger& divisor,
+                       const big_num_arithmetic::BigInteger& bound,
+                       Coefficients& divisors) {
+  if (index == factors.size()) {
+    divisors.push_back(divisor);
+    return;
+  }
+  big_num_arithmetic::BigInteger multiple = divisor;
+  for (uint64_t i = 0; i <= factors[index].exponent; ++i) {
+    if (i != 0) {
+      multiple *= factors[index].prime;
+      if (multiple > bound) {
+        return;
+      }
+    }
+    EnumerateDivisors(factors, index + 1, multiple, bound, divisors);
+  }
+}
+
+// The positive divisors of N > 0 in ascending order.
+Coefficients Divisors(const big_num_arithmetic::BigInteger& n) {
+  Coefficients divisors;
+  EnumerateDivisors(Factorize(n), 0, big_num_arithmetic::BigInteger(1), n,
+                    divisors);
+  std::sort(divisors.begin(), divisors.end());
+  return divisors;
+}
+
+// ARITHMETIC MODULO A WORD PRIME
+
+std::vector<uint64_t> ReduceCoefficients(const Coefficients& coefficients,
+                                         uint32_t modulus) {
+  std::vector<uint64_t> residues;
+  residues.reserve(coefficients.size());
+  for (const big_num_arithmetic::BigInteger& coefficient : coefficients) {
+    residues.push_back(Residue(coefficient, modulus));
+  }
+  return residues;
+}
+
+uint64_t EvaluateModulo(const std::vector<uint64_t>& residues, uint64_t x,
+                        uint64_t modulus) {
+  uint64_t value = 0;
+  for (size_t i = residues.size(); i-- > 0;) {
+    value = (value * x + residues[i]) % modulus;
+  }
+  return value;
+}
+
+uint64_t InverseModulo(uint64_t value, uint64_t modulus) {
+  // Fermat: value^(modulus - 2).
+  uint64_t result = 1;
+  for (uint64_t exponent = modulus - 2; exponent != 0; exponent >>= 1) {
+    if (exponent & 1) {
+      result = result * value % modulus;
+    }
+    value = value * value % modulus;
+  }
+  return result;
+}
+
+// Degree of the gcd of two polynomials modulo a prime, by Euclid's
+// algorithm; the polynomials must have nonzero leading coefficients.
+size_t GcdDegreeModulo(std::vector<uint64_t> lhs, std::vector<uint64_t> rhs,
+                       uint64_t modulus) {
+  while (!rhs.empty()) {
+    uint64_t inverse = InverseModulo(rhs.back(), modulus);
+    while (lhs.size() >= rhs.size()) {
+      uint64_t factor = lhs.back() * inverse % modulus;
+      size_t shift = lhs.size() - rhs.size();
+      for (size_t j = 0; j < rhs.size(); ++j) {
+        lhs[shift + j] =
+            (lhs[shift + j] + (modulus - factor) * rhs[j]) % modulus;
+      }
+      while (!lhs.empty() && lhs.back() == 0) {
+        lhs.pop_back();
+      }
+    }
+    lhs.swap(rhs);
+  }
+  return lhs.size() - 1;
+}
+
+// SQUAREFREE PART
+
+Coefficients Derivative(const Coefficients& coefficients) {
+  Coefficients derivative;
+  for (size_t i = 1; i < coefficients.size(); ++i) {
+    derivative.push_back(coefficients[i] * static_cast<int64_t>(i));
+  }
+  return derivative;
+}
+
+// Divides out the gcd of the coefficients and makes the leading one
+// positive.
+void MakePrimitive(Coefficients& coefficients) {
+  big_num_arithmetic::BigInteger content;
+  for (const big_num_arithmetic::BigInteger& coefficient : coefficients) {
+    content = big_num_arithmetic::BigInteger::Gcd(content, coefficient);
+  }
+  if (coefficients.back() < 0) {
+    content.Negate();
+  }
+  for (big_num_arithmetic::BigInteger& coefficient : coefficients) {
+    coefficient = big_num_arithmetic::BigInteger::DivExact(coefficient,
+                                                           content);
+  }
+}
+
+// lc(RHS)^(deg LHS - deg RHS + 1) LHS mod RHS, without the zeros on top.
+Coefficients PseudoRemainder(Coefficients lhs, const Coefficients& rhs) {
+  while (lhs.size() >= rhs.size()) {
+    big_num_arithmetic::BigInteger lead = lhs.back();
+    size_t shift = lhs.size() - rhs.size();
+    for (big_num_arithmetic::BigInteger& coefficient : lhs) {
+      coefficient *= rhs.back();
+    }
+    for (size_t j = 0; j < rhs.size(); ++j) {
+      lhs[shift + j] -= lead * rhs[j];
+    }
+    while (!lhs.empty() && lhs.back() == 0) {
+      lhs.pop_back();
+    }
+  }
+  return lhs;
+}
+
+// The primitive gcd of two nonzero polynomials by the primitive remainder
+// sequence, which keeps the coefficients small by their contents.
+Coefficients PolynomialGcd(Coefficients lhs, Coefficients rhs) {
+  MakePrimitive(lhs);
+  MakePrimitive(rhs);
+  if (lhs.size() < rhs.size()) {
+    lhs.swap(rhs);
+  }
+  while (!rhs.empty()) {
+    Coefficients remainder = PseudoRemainder(lhs, rhs);
+    if (!remainder.empty()) {
+      MakePrimitive(remainder);
+    }
+    lhs.swap(rhs);
+    rhs.swap(remainder);
+  }
+  return lhs;
+}
+
+// LHS / RHS for a primitive RHS that divides LHS.
+Coefficients DivideExactly(Coefficients lhs, const Coefficients& rhs) {
+  Coefficients quotient(lhs.size() - rhs.size() + 1);
+  for (size_t shift = quotient.size(); shift-- > 0;) {
+    quotient[shift] = big_num_arithmetic::BigInteger::DivExact(
+        lhs[shift + rhs.size() - 1], rhs.back());
+    for (size_t j = 0; j < rhs.size(); ++j) {
+      lhs[shift + j] -= quotient[shift] * rhs[j];
+    }
+  }
+  return quotient;
+}
+
+// The primitive polynomial with the roots of COEFFICIENTS, each once:
+// P / gcd(P, P'). The gcd is only computed if the one modulo a word prime
+// isn't 1, which it is for almost all polynomials without repeated roots.
+Coefficients SquarefreePart(Coefficients coefficients) {
+  Coefficients derivative = Derivative(coefficients);
+  uint32_t modulus = kFilterPrimes[0];
+  if (Residue(coefficients.back(), modulus) == 0 ||
+      GcdDegreeModulo(ReduceCoefficients(coefficients, modulus),
+                      ReduceCoefficients(derivative, modulus),
+                      modulus) != 0) {
+    Coefficients gcd = PolynomialGcd(coefficients, derivative);
+    MakePrimitive(coefficients);
+    coefficients = DivideExactly(std::move(coefficients), gcd);
+  }
+  MakePrimitive(coefficients);
+  return coefficients;
+}
+
+// P-ADIC ROOTS
+
+bool IsSmallPrime(uint64_t n) {
+  for (uint64_t divisor = 2; divisor * divisor <= n; ++divisor) {
+    if (n % divisor == 0) {
+      return false;
+    }
+  }
+  return n >= 2;
+}
+
+// Finds a prime l not dividing the leading coefficient at which every root
+// of the squarefree polynomial modulo l is simple, and writes these roots.
+// All the values at 0, ..., l - 1 are computed, so l starts a little
+// above the degree and is doubled after every failure: a prime where two
+// of n roots meet is likely below n^2.
+uint32_t FindSimpleRoots(const Coefficients& squarefree,
+                         const Coefficients& derivative,
+                         std::vector<uint64_t>& roots) {
+  uint64_t candidate = std::max<uint64_t>(kMinRootModulus,
+                                          2 * squarefree.size());
+  while (true) {
+    while (!IsSmallPrime(candidate)) {
+      ++candidate;
+    }
+    uint32_t modulus = static_cast<uint32_t>(candidate);
+    std::vector<uint64_t> residues =
+        ReduceCoefficients(squarefree, modulus);
+    std::vector<uint64_t> slopes = ReduceCoefficients(derivative, modulus);
+    bool simple = residues.back() != 0;
+    roots.clear();
+    for (uint64_t x = 0; simple && x < modulus; ++x) {
+      if (EvaluateModulo(residues, x, modulus) == 0) {
+        simple = EvaluateModulo(slopes, x, modulus) != 0;
+        roots.push_back(x);
+      }
+    }
+    if (simple) {
+      return modulus;
+    }
+    candidate *= 2;
+  }
+}
+
+// VALUE mod MODULUS in [0, |MODULUS|).
+big_num_arithmetic::BigInteger Reduce(
+    const big_num_arithmetic::BigInteger& value,
+    const big_num_arithmetic::Divisor& modulus) {
+  big_num_arithmetic::BigInteger remainder = value % modulus;
+  if (remainder < 0) {
+    remainder += modulus.Value();
+  }
+  return remainder;
+}
+
+// The value at x modulo MODULUS of a polynomial with reduced
+// coefficients.
+big_num_arithmetic::BigInteger EvaluateReduced(
+    const Coefficients& residues, const big_num_arithmetic::BigInteger& x,
+    const big_num_arithmetic::Divisor& modulus) {
+  big_num_arithmetic::BigInteger value;
+  for (size_t i = residues.size(); i-- > 0;) {
+    value = Reduce(value * x + residues[i], modulus);
+  }
+  return value;
+}
+
+// Lifts the simple roots modulo l to roots modulo l^(2^k) > BOUND by
+// Newton's iteration x -> x - P(x) / P'(x), which doubles the exponent at
+// every step, and returns l^(2^k). The coefficients are reduced once per
+// step, so the evaluations work on numbers of the size of the modulus.
+big_num_arithmetic::BigInteger LiftRoots(
+    const Coefficients& squarefree, const Coefficients& derivative,
+    uint32_t prime, const big_num_arithmetic::BigInteger& bound,
+    Coefficients& roots) {
+  big_num_arithmetic::BigInteger modulus(int64_t{prime});
+  Coefficients residues;
+  Coefficients slopes;
+  while (modulus <= bound) {
+    modulus *= modulus;
+    big_num_arithmetic::Divisor divisor(modulus);
+    residues.clear();
+    for (const big_num_arithmetic::BigInteger& coefficient : squarefree) {
+      residues.push_back(Reduce(coefficient, divisor));
+    }
+    slopes.clear();
+    for (const big_num_arithmetic::BigInteger& coefficient : derivative) {
+      slopes.push_back(Reduce(coefficient, divisor));
+    }
+    for (big_num_arithmetic::BigInteger& root : roots) {
+      big_num_arithmetic::BigInteger slope =
+          EvaluateReduced(slopes, root, divisor);
+      root = Reduce(root - EvaluateReduced(residues, root, divisor) *
+                               big_num_arithmetic::BigInteger::ModInverse(
+                                   slope, modulus),
+                    divisor);
+    }
+  }
+  return modulus;
+}
+
+// ROOTS
+
+// Tests whether the polynomial may vanish at p / q by the value of
+// q^n P(p / q) = sum c_i p^i q^(n - i) modulo each of kFilterPrimes.
+class ModularFilter {
+ public:
+  explicit ModularFilter(const Coefficients& coefficients) {
+    for (size_t k = 0; k < kFilterPrimes.size(); ++k) {
+      residues_[k].reserve(coefficients.size());
+      for (const big_num_arithmetic::BigInteger& coefficient :
+           coefficients) {
+        residues_[k].push_back(Residue(coefficient, kFilterPrimes[k]));
+      }
+    }
+  }
+
+  bool MayBeRoot(const big_num_arithmetic::BigInteger& numerator,
+                 const big_num_arithmetic::BigInteger& denominator) const {
+    for (size_t k = 0; k < kFilterPrimes.size(); ++k) {
+      uint64_t modulus = kFilterPrimes[k];
+      uint64_t p = Residue(numerator, kFilterPrimes[k]);
+      uint64_t q = Residue(denominator, kFilterPrimes[k]);
+      const std::vector<uint64_t>& residues = residues_[k];
+      uint64_t value = residues.back();
+      uint64_t q_power = 1;
+      for (size_t i = residues.size() - 1; i-- > 0;) {
+        q_power = q_power * q % modulus;
+        value = (value * p + residues[i] * q_power % modulus) % modulus;
+      }
+      if (value != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::array<std::vector<uint64_t>, kFilterPrimes.size()> residues_;
+};
+
+// If (q x - p) divides the polynomial, writes the quotient and returns
+// true. The quotient has integer coefficients for p / q in lowest terms
+// (Gauss's lemma): c_i = q d_(i - 1) - p d_i gives them from the top.
+bool DivideByLinear(const Coefficients& coefficients,
+                    const big_num_arithmetic::BigInteger& numerator,
+                    const big_num_arithmetic::Divisor& denominator,
+                    Coefficients& quotient) {
+  size_t degree = coefficients.size() - 1;
+  quotient.assign(degree, big_num_arithmetic::BigInteger());
+  big_num_arithmetic::BigInteger carry = coefficients[degree];
+  big_num_arithmetic::BigInteger remainder;
+  bool is_integer = denominator.Value() == 1;
+  for (size_t i = degree; i > 0; --i) {
+    if (is_integer) {
+      quotient[i - 1] = std::move(carry);
+    } else {
+      denominator.DivMod(carry, quotient[i - 1], remainder);
+      if (remainder != 0) {
+        return false;
+      }
+    }
+    carry = coefficients[i - 1] + numerator * quotient[i - 1];
+  }
+  return carry == 0;
+}
+
+struct Root {
+  big_num_arithmetic::BigInteger numerator;
+  big_num_arithmetic::BigInteger denominator;
+};
+
+// The roots with denominators 1 only, or with all the denominators if
+// RATIONAL is set, in ascending order and repeated by multiplicity.
+//
+// A rational root p / q of P in lowest terms is a simple root of the
+// squarefree part S, and q divides its leading coefficient. The roots of S
+// modulo a prime l are lifted to l-adic roots x to a precision l^k above
+// 2 |lc(S)| times a bound of the roots; then p = q x mod l^k for every
+// candidate q, with |p| below q times the bound.
+std::vector<Root> FindRoots(Coefficients coefficients, bool rational) {
+  std::vector<Root> roots;
+  size_t zeros = 0;
+  while (coefficients[zeros] == 0) {
+    ++zeros;
+  }
+  for (size_t i = 0; i < zeros; ++i) {
+    roots.push_back({big_num_arithmetic::BigInteger(),
+                     big_num_arithmetic::BigInteger(1)});
+  }
+  coefficients.erase(coefficients.begin(), coefficients.begin() + zeros);
+
+  if (coefficients.size() > 1) {
+    Coefficients squarefree = SquarefreePart(coefficients);
+    Coefficients derivative = Derivative(squarefree);
+    const big_num_arithmetic::BigInteger& leading = squarefree.back();
+    // Fujiwara's bound: every root has |x| <= 2 max |c_(n - i) / c_n|^(1/i),
+    // which is near twice the biggest root.
+    size_t degree = squarefree.size() - 1;
+    big_num_arithmetic::BigInteger bound(0);
+    for (size_t i = 1; i <= degree; ++i) {
+      big_num_arithmetic::BigInteger ratio =
+          (squarefree[degree - i].abs() + leading - 1) / leading;
+      bound = std::max(bound,
+                       big_num_arithmetic::BigInteger::IRoot(ratio, i) + 1);
+    }
+    bound *= 2;
+
+    Coefficients denominators{big_num_arithmetic::BigInteger(1)};
+    if (rational) {
+      denominators = Divisors(leading);
+    }
+    std::vector<uint64_t> short_roots;
+    uint32_t prime = FindSimpleRoots(squarefree, derivative, short_roots);
+    Coefficients lifted;
+    for (uint64_t root : short_roots) {
+      lifted.push_back(big_num_arithmetic::BigInteger(root));
+    }
+    big_num_arithmetic::BigInteger modulus =
+        LiftRoots(squarefree, derivative, prime, 2 * leading * bound, lifted);
+    big_num_arithmetic::BigInteger half_modulus = modulus >> 1;
+    big_num_arithmetic::Divisor reduction(modulus);
+
+    ModularFilter filter(coefficients);
+    Coefficients remaining = coefficients;
+    Coefficients quotient;
+    for (const big_num_arithmetic::BigInteger& q : denominators) {
+      big_num_arithmetic::Divisor divisor(q);
+      for (const big_num_arithmetic::BigInteger& root : lifted) {
+        // The representative of q x in (-l^k / 2, l^k / 2].
+        big_num_arithmetic::BigInteger p = Reduce(root * q, reduction);
+        if (p > half_modulus) {
+          p -= modulus;
+        }
+        if (p.abs() > bound * q ||
+            (q != 1 && big_num_arithmetic::BigInteger::Gcd(p, q) != 1) ||
+            !filter.MayBeRoot(p, q)) {
+          continue;
+        }
+        while (remaining.size() > 1 &&
+               DivideByLinear(remaining, p, divisor, quotient)) {
+          roots.push_back({p, q});
+          remaining.swap(quotient);
+        }
+      }
+    }
+  }
+  std::sort(roots.begin(), roots.end(), [](const Root& lhs, const Root& rhs) {
+    return lhs.numerator * rhs.denominator < rhs.numerator * lhs.denominator;
+  });
+  return roots;
+}
+
+}  // namespace
+
+int64_t Degree(const PolynomialEquation& equation) {
+  int64_t degree = static_cast<int64_t>(equation.coefficients.size()) - 1;
+  while (degree >= 0 && equation.coefficients[degree] == 0) {
+    --degree;
+  }
+  return degree;
+}
+
+PolynomialEquation GenerateEquation(
+    const big_num_arithmetic::BigInteger& a,
+    const std::vector<big_num_arithmetic::BigInteger>& roots) {
+  // Multiplying by one linear factor at a time is linear in the size of
+  // the product; a product tree of Karatsuba products measured slower at
+  // every degree.
+  Coefficients product{big_num_arithmetic::BigInteger(1)};
+  for (const big_num_arithmetic::BigInteger& root : roots) {
+    // (x - r) (c_0 + c_1 x + ...): c_i becomes c_(i - 1) - r c_i.
+    product.push_back(product.back());
+    for (size_t i = product.size() - 2; i > 0; --i) {
+      product[i] = product[i - 1] - root * product[i];
+    }
+    product[0] = -root * product[0];
+  }
+  PolynomialEquation equation{std::move(product)};
+  for (big_num_arithmetic::BigInteger& coefficient :
+       equation.coefficients) {
+    coefficient *= a;
+  }
+  return equation;
+}
+
+big_num_arithmetic::BigInteger Evaluate(
+    const PolynomialEquation& equation,
+    const big_num_arithmetic::BigInteger& x) {
+  return EvaluateTrimmed(Trimmed(equation), Coefficients{x})[0];
+}
+
+std::vector<big_num_arithmetic::BigInteger> Evaluate(
+    const PolynomialEquation& equation,
+    const std::vector<big_num_arithmetic::BigInteger>& points) {
+  return EvaluateTrimmed(Trimmed(equation), points);
+}
+
+bool Solve(const PolynomialEquation& equation,
+           std::vector<big_num_arithmetic::BigInteger>& roots) {
+  Coefficients coefficients = Trimmed(equation);
+  if (coefficients.empty()) {
+    throw std::invalid_argument("Zero polynomial");
+  }
+  roots.clear();
+  for (Root& root : FindRoots(coefficients, false)) {
+    roots.push_back(std::move(root.numerator));
+  }
+  return roots.size() + 1 == coefficients.size();
+}
+
+bool SolveRational(const PolynomialEquation& equation,
+                   std::vector<big_num_arithmetic::BigRational>& roots) {
+  Coefficients coefficients = Trimmed(equation);
+  if (coefficients.empty()) {
+    throw std::invalid_argument("Zero polynomial");
+  }
+  roots.clear();
+  for (Root& root : FindRoots(coefficients, true)) {
+    roots.emplace_back(std::move(root.numerator),
+                       std::move(root.denominator));
+  }
+  return roots.size() + 1 == coefficients.size();
+}
+
 namespace helpers {
 
+namespace {
+
+// Size of VALUE for the instrumentation counters.
+template <typename T>
+uint64_t LimbCount(const T& value) {
+  if constexpr (std::is_same_v<T, big_num_arithmetic::BigInteger>) {
+    return value.Limbs().size();
+  }
+  return 1;
+}
+
+}  // namespace
+
 template <typename T>
 T Sqrt(const T& value) {
   T zero = value - value;
@@ -46,6 +818,7 @@ T Sqrt(const T& value) {
   T right = value;
   T middle = (T) 0;
   while (left <= right) {
+    BIG_INTEGER_COUNT(kSqrtIteration, LimbCount(value), 0);
     middle = (left + right) / (one + one);
     if (middle < value / middle) {
       left = middle + one;
@@ -2,29 +2,94 @@
 #define EQUATION_SOLVER_H_
 
 #include "big_integer.h"
+#include "big_rational.h"
+#include "shared_big_integer.h"
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 // namespace big_num_arithmetic {
 
 namespace equation_solver {
 
+// a x^2 + b x + c = 0. Copies of an equation share the digits of the
+// coefficients, as do equations generated from the same shared a.
 struct QuadraticEquation {
-  QuadraticEquation() = default;
-  big_num_arithmetic::BigInteger a{0};
-  big_num_arithmetic::BigInteger b{0};
-  big_num_arithmetic::BigInteger c{0};
+  big_num_arithmetic::SharedBigInteger a;
+  big_num_arithmetic::SharedBigInteger b;
+  big_num_arithmetic::SharedBigInteger c;
 };
 
-QuadraticEquation GenerateEquation(const big_num_arithmetic::BigInteger& a,
-                                 const big_num_arithmetic::BigInteger& root_1,
-                                 const big_num_arithmetic::BigInteger& root_2);
+QuadraticEquation GenerateEquation(
+    const big_num_arithmetic::SharedBigInteger& a,
+    const big_num_arithmetic::BigInteger& root_1,
+    const big_num_arithmetic::BigInteger& root_2);
 
 bool Solve(const QuadraticEquation& equation,
            big_num_arithmetic::BigInteger& root_1,
            big_num_arithmetic::BigInteger& root_2);
 
+// The exact roots (-b -+ sqrt(D)) / 2a, where Solve() truncates them.
+// Returns false if they are not rational, i.e. if the discriminant D is
+// negative or not a perfect square.
+bool SolveRational(const QuadraticEquation& equation,
+                   big_num_arithmetic::BigRational& root_1,
+                   big_num_arithmetic::BigRational& root_2);
+
+// c_0 + c_1 x + ... + c_n x^n = 0 with coefficients[i] = c_i. Zeros at
+// the end of the vector don't count for the degree.
+struct PolynomialEquation {
+  std::vector<big_num_arithmetic::BigInteger> coefficients;
+};
+
+constexpr size_t kSplitThreshold = 64;
+constexpr size_t kSplitDigits = 8;
+
+// -1 for the zero polynomial.
+int64_t Degree(const PolynomialEquation& equation);
+
+// a (x - r_1) ... (x - r_n), multiplied out one linear factor at a time.
+PolynomialEquation GenerateEquation(
+    const big_num_arithmetic::BigInteger& a,
+    const std::vector<big_num_arithmetic::BigInteger>& roots);
+
+// The value of the polynomial at x.
+big_num_arithmetic::BigInteger Evaluate(
+    const PolynomialEquation& equation,
+    const big_num_arithmetic::BigInteger& x);
+// The values at all the points, by Horner's scheme over the whole batch,
+// one coefficient for all points at a time. Points of kSplitDigits digits
+// or more on polynomials of kSplitThreshold coefficients or more are
+// split instead: P = L + x^(2^k) H down a tree of the powers x^(2^k).
+// Horner's scheme multiplies a long value by x at every step, which is
+// cheap for short x only; the split multiplies values of equal length.
+std::vector<big_num_arithmetic::BigInteger> Evaluate(
+    const PolynomialEquation& equation,
+    const std::vector<big_num_arithmetic::BigInteger>& points);
+
+// The integer roots in ascending order, each as often as its multiplicity.
+// Returns whether these are all the roots, Degree() of them. Throws
+// std::invalid_argument for the zero polynomial.
+//
+// The roots are those of the squarefree part S = P / gcd(P, P'), whose
+// roots are all simple. They are found modulo a small prime l where S
+// stays squarefree, and lifted by Newton's iteration to a power of l
+// above the bound of the roots times c_n. By the rational root theorem a
+// root p / q in lowest terms has q | c_n, so for every divisor q of c_n
+// the symmetric residue of q x is the only candidate p for the lifted x.
+// Only c_n is factored, by trial division, perfect powers and Pollard's
+// rho. A candidate must give zero modulo two word primes, a pass over the
+// coefficients in machine words, before the exact division by q x - p
+// confirms it and takes it out of the polynomial as often as it divides.
+bool Solve(const PolynomialEquation& equation,
+           std::vector<big_num_arithmetic::BigInteger>& roots);
+// The same for the rational roots.
+bool SolveRational(const PolynomialEquation& equation,
+                   std::vector<big_num_arithmetic::BigRational>& roots);
+
 namespace helpers {
 
 template<typename T>
@@ -1,5 +1,8 @@
 #include "equation_solver.h"
 #include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+#include <vector>
 
 namespace equation_solver {
 
@@ -86,4 +89,204 @@ TEST(Test_14, ExeptionChecking) {
   }
 }
 
+TEST(Test_47, RationalRoots) {
+  using big_num_arithmetic::BigInteger;
+  using big_num_arithmetic::BigRational;
+  BigRational root_1;
+  BigRational root_2;
+  // 6 x^2 - 5 x + 1 = (2 x - 1) (3 x - 1).
+  QuadraticEquation equation{BigInteger(6), BigInteger(-5), BigInteger(1)};
+  EXPECT_TRUE(SolveRational(equation, root_1, root_2));
+  EXPECT_EQ(root_1.ToString(), "1/3");
+  EXPECT_EQ(root_2.ToString(), "1/2");
+  BigInteger truncated_1;
+  BigInteger truncated_2;
+  EXPECT_TRUE(Solve(equation, truncated_1, truncated_2));
+  EXPECT_TRUE(truncated_1 == 0 && truncated_2 == 0);
+
+  BigInteger big = (BigInteger(1) << 300) + 7;
+  equation = GenerateEquation(BigInteger(-4), big, -big);
+  EXPECT_TRUE(SolveRational(equation, root_1, root_2));
+  EXPECT_TRUE(root_1 == BigRational(big) && root_2 == BigRational(-big));
+
+  equation = QuadraticEquation{BigInteger(1), BigInteger(0), BigInteger(-2)};
+  EXPECT_FALSE(SolveRational(equation, root_1, root_2));
+  equation = QuadraticEquation{BigInteger(1), BigInteger(0), BigInteger(2)};
+  EXPECT_FALSE(SolveRational(equation, root_1, root_2));
+}
+
+TEST(Test_50, PolynomialEvaluation) {
+  using big_num_arithmetic::BigInteger;
+  PolynomialEquation zero;
+  EXPECT_EQ(Degree(zero), -1);
+  EXPECT_TRUE(Evaluate(zero, BigInteger(5)) == 0);
+  // 2 x^3 - x + 7, with zeros on top.
+  PolynomialEquation cubic{{BigInteger(7), BigInteger(-1), BigInteger(0),
+                            BigInteger(2), BigInteger(0)}};
+  EXPECT_EQ(Degree(cubic), 3);
+  EXPECT_TRUE(Evaluate(cubic, BigInteger(0)) == 7);
+  EXPECT_TRUE(Evaluate(cubic, BigInteger(-3)) == -44);
+  EXPECT_TRUE(Evaluate(cubic, BigInteger(1) << 100) ==
+              (BigInteger(1) << 301) - (BigInteger(1) << 100) + 7);
+
+  // (x - 1) (x + 2) (x - 3) = x^3 - 2 x^2 - 5 x + 6.
+  PolynomialEquation generated =
+      GenerateEquation(BigInteger(-2), {BigInteger(1), BigInteger(-2),
+                                        BigInteger(3)});
+  ASSERT_EQ(generated.coefficients.size(), 4u);
+  EXPECT_TRUE(generated.coefficients[0] == -12 &&
+              generated.coefficients[1] == 10 &&
+              generated.coefficients[2] == 4 &&
+              generated.coefficients[3] == -2);
+  EXPECT_TRUE(GenerateEquation(BigInteger(5), {}).coefficients[0] == 5);
+
+  std::mt19937_64 rng(50);
+  for (size_t degree : {3, 40, 63, 64, 200}) {
+    std::vector<BigInteger> roots;
+    for (size_t i = 0; i < degree; ++i) {
+      roots.push_back(BigInteger::Random(1 + rng() % 100, rng) -
+                      BigInteger::Random(1 + rng() % 100, rng));
+    }
+    PolynomialEquation equation = GenerateEquation(BigInteger(3), roots);
+    ASSERT_EQ(Degree(equation), static_cast<int64_t>(degree));
+    // Multiplying the linear factors one by one.
+    std::vector<BigInteger> expected{BigInteger(3)};
+    for (const BigInteger& root : roots) {
+      expected.insert(expected.begin(), BigInteger());
+      for (size_t i = 0; i + 1 < expected.size(); ++i) {
+        expected[i] -= root * expected[i + 1];
+      }
+    }
+    EXPECT_TRUE(equation.coefficients == expected);
+
+    std::vector<BigInteger> points(roots.begin(), roots.begin() + 3);
+    for (int i = 0; i < 20; ++i) {
+      points.push_back(BigInteger::Random(rng() % 300, rng) *
+                       (i % 2 == 0 ? 1 : -1));
+    }
+    std::vector<BigInteger> values = Evaluate(equation, points);
+    ASSERT_EQ(values.size(), points.size());
+    for (size_t j = 0; j < points.size(); ++j) {
+      BigInteger horner;
+      for (size_t i = expected.size(); i-- > 0;) {
+        horner = horner * points[j] + expected[i];
+      }
+      EXPECT_TRUE(values[j] == horner);
+      EXPECT_TRUE(Evaluate(equation, points[j]) == horner);
+    }
+    EXPECT_TRUE(values[0] == 0 && values[1] == 0 && values[2] == 0);
+  }
+}
+
+TEST(Test_51, PolynomialRoots) {
+  using big_num_arithmetic::BigInteger;
+  using big_num_arithmetic::BigRational;
+  std::vector<BigInteger> roots;
+  std::vector<BigRational> rational_roots;
+  EXPECT_THROW(Solve(PolynomialEquation{}, roots), std::invalid_argument);
+  EXPECT_THROW(SolveRational(PolynomialEquation{{BigInteger(0)}},
+                             rational_roots),
+               std::invalid_argument);
+  EXPECT_TRUE(Solve(PolynomialEquation{{BigInteger(4)}}, roots));
+  EXPECT_TRUE(roots.empty());
+
+  // x^2 + 1 and x^2 - 2 have no rational roots.
+  EXPECT_FALSE(Solve(PolynomialEquation{{BigInteger(1), BigInteger(0),
+                                         BigInteger(1)}}, roots));
+  EXPECT_FALSE(SolveRational(PolynomialEquation{{BigInteger(-2),
+                                                 BigInteger(0),
+                                                 BigInteger(1)}},
+                             rational_roots));
+  EXPECT_TRUE(rational_roots.empty());
+
+  // x^3 (x - 2)^2 (x + 5) (x^2 + x + 1).
+  PolynomialEquation equation = GenerateEquation(
+      BigInteger(7), {BigInteger(0), BigInteger(0), BigInteger(0),
+                      BigInteger(2), BigInteger(-5), BigInteger(2)});
+  PolynomialEquation factor{{BigInteger(1), BigInteger(1), BigInteger(1)}};
+  std::vector<BigInteger> product(equation.coefficients.size() + 2);
+  for (size_t i = 0; i < equation.coefficients.size(); ++i) {
+    for (size_t j = 0; j < 3; ++j) {
+      product[i + j] += equation.coefficients[i] * factor.coefficients[j];
+    }
+  }
+  EXPECT_FALSE(Solve(PolynomialEquation{product}, roots));
+  EXPECT_TRUE(roots == std::vector<BigInteger>({BigInteger(-5), BigInteger(),
+                                                BigInteger(), BigInteger(),
+                                                BigInteger(2),
+                                                BigInteger(2)}));
+
+  // 6 x^3 - 5 x^2 - 2 x + 1 = (2 x + 1) (3 x - 1) (x - 1).
+  equation = PolynomialEquation{{BigInteger(1), BigInteger(-2),
+                                 BigInteger(-5), BigInteger(6)}};
+  EXPECT_FALSE(Solve(equation, roots));
+  EXPECT_TRUE(roots == std::vector<BigInteger>{BigInteger(1)});
+  EXPECT_TRUE(SolveRational(equation, rational_roots));
+  ASSERT_EQ(rational_roots.size(), 3u);
+  EXPECT_EQ(rational_roots[0].ToString(), "-1/2");
+  EXPECT_EQ(rational_roots[1].ToString(), "1/3");
+  EXPECT_EQ(rational_roots[2].ToString(), "1");
+
+  // Roots with factors that trial division doesn't find.
+  std::mt19937_64 rng(51);
+  std::vector<BigInteger> expected;
+  for (int i = 0; i < 12; ++i) {
+    expected.push_back((BigInteger::Random(40, rng) + 1) *
+                       (i % 3 == 0 ? -1 : 1));
+  }
+  expected.push_back(expected[0]);
+  expected.push_back(BigInteger(1) << 70);
+  equation = GenerateEquation(BigInteger(-6), expected);
+  std::sort(expected.begin(), expected.end());
+  EXPECT_TRUE(Solve(equation, roots));
+  EXPECT_TRUE(roots == expected);
+  EXPECT_TRUE(SolveRational(equation, rational_roots));
+  ASSERT_EQ(rational_roots.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_TRUE(rational_roots[i] == BigRational(expected[i]));
+  }
+
+  // (x^2 + 1)^2 (3 x - 2)^2 (5 x + 7) (2^61 - 1) x + 1), with repeated
+  // factors for the squarefree part and a prime leading coefficient.
+  auto multiply = [](const std::vector<BigInteger>& lhs,
+                     const std::vector<BigInteger>& rhs) {
+    std::vector<BigInteger> product(lhs.size() + rhs.size() - 1);
+    for (size_t i = 0; i < lhs.size(); ++i) {
+      for (size_t j = 0; j < rhs.size(); ++j) {
+        product[i + j] += lhs[i] * rhs[j];
+      }
+    }
+    return product;
+  };
+  BigInteger mersenne = (BigInteger(1) << 61) - 1;
+  std::vector<BigInteger> square{BigInteger(1), BigInteger(0),
+                                 BigInteger(1)};
+  std::vector<BigInteger> linear{BigInteger(-2), BigInteger(3)};
+  std::vector<BigInteger> coefficients = multiply(
+      multiply(multiply(square, square), multiply(linear, linear)),
+      multiply({BigInteger(7), BigInteger(5)}, {BigInteger(1), mersenne}));
+  equation = PolynomialEquation{coefficients};
+  EXPECT_FALSE(Solve(equation, roots));
+  EXPECT_TRUE(roots.empty());
+  EXPECT_FALSE(SolveRational(equation, rational_roots));
+  ASSERT_EQ(rational_roots.size(), 4u);
+  EXPECT_TRUE(rational_roots[0] ==
+              BigRational(BigInteger(-7), BigInteger(5)));
+  EXPECT_TRUE(rational_roots[1] == BigRational(BigInteger(-1), mersenne));
+  EXPECT_TRUE(rational_roots[2] ==
+              BigRational(BigInteger(2), BigInteger(3)));
+  EXPECT_TRUE(rational_roots[3] == rational_roots[2]);
+
+  // Many roots, which meet modulo the small primes.
+  expected.clear();
+  for (int i = 0; i < 100; ++i) {
+    expected.push_back(BigInteger::Random(1 + rng() % 200, rng) -
+                       BigInteger::Random(1 + rng() % 200, rng));
+  }
+  equation = GenerateEquation(BigInteger(1), expected);
+  std::sort(expected.begin(), expected.end());
+  EXPECT_TRUE(Solve(equation, roots));
+  EXPECT_TRUE(roots == expected);
+}
+
 }  // namespace equation_solver
\ No newline at end of file
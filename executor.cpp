@@ -0,0 +1,116 @@
+#include "executor.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace big_num_arithmetic {
+
+void ParallelFor(Executor* executor, size_t count,
+                 const std::function<void(size_t)>& task) {
+  if (executor == nullptr || count <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+  executor->ParallelFor(count, task);
+}
+
+// One ParallelFor() call. Every thread that has the job takes the next
+// unclaimed index until there are none.
+struct ThreadPoolExecutor::Job {
+  Job(size_t job_count, const std::function<void(size_t)>& job_task)
+      : count(job_count), task(job_task) {}
+
+  // Runs the tasks that are still unclaimed.
+  void Help() {
+    for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+      if (finished.fetch_add(1) + 1 == count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        all_finished.notify_all();
+      }
+    }
+  }
+
+  const size_t count;
+  const std::function<void(size_t)>& task;
+  std::atomic<size_t> next{0};
+  std::atomic<size_t> finished{0};
+  std::mutex mutex;
+  std::condition_variable all_finished;
+  std::exception_ptr error;
+};
+
+ThreadPoolExecutor::ThreadPoolExecutor(size_t threads) {
+  // The calling thread works too, so the pool needs one thread less.
+  for (size_t i = 1; i < std::max<size_t>(threads, 1); ++i) {
+    workers_.emplace_back([this] { WorkerLoop(); });
+  }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  has_jobs_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+size_t ThreadPoolExecutor::Concurrency() const {
+  return workers_.size() + 1;
+}
+
+void ThreadPoolExecutor::ParallelFor(
+    size_t count, const std::function<void(size_t)>& task) {
+  auto job = std::make_shared<Job>(count, task);
+  size_t helpers = std::min(count - 1, workers_.size());
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < helpers; ++i) {
+      jobs_.push_back(job);
+    }
+  }
+  for (size_t i = 0; i < helpers; ++i) {
+    has_jobs_.notify_one();
+  }
+
+  job->Help();
+  {
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->all_finished.wait(lock, [&job] {
+      return job->finished.load() == job->count;
+    });
+  }
+  if (job->error) {
+    std::rethrow_exception(job->error);
+  }
+}
+
+void ThreadPoolExecutor::WorkerLoop() {
+  while (true) {
+    std::shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      has_jobs_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+      if (jobs_.empty()) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+    }
+    job->Help();
+  }
+}
+
+}  // namespace big_num_arithmetic
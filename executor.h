@@ -0,0 +1,63 @@
+#ifndef EXECUTOR_H_
+#define EXECUTOR_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace big_num_arithmetic {
+
+// Runs independent tasks for the parallel algorithms. Passing nullptr
+// instead of an executor everywhere means running on the calling thread.
+class Executor {
+ public:
+  virtual ~Executor() = default;
+
+  // Calls task(i) for every i in [0, count) and returns when all the calls
+  // are finished. Tasks may call ParallelFor() again.
+  virtual void ParallelFor(size_t count,
+                           const std::function<void(size_t)>& task) = 0;
+
+  // Number of threads that may run tasks at the same time.
+  virtual size_t Concurrency() const = 0;
+};
+
+// Runs ParallelFor(executor, ...) on the executor, or on the calling thread
+// if there is none.
+void ParallelFor(Executor* executor, size_t count,
+                 const std::function<void(size_t)>& task);
+
+// Fixed pool of threads. The thread calling ParallelFor() takes tasks of
+// its own call as well, so nested calls can't lock the pool up.
+class ThreadPoolExecutor : public Executor {
+ public:
+  explicit ThreadPoolExecutor(
+      size_t threads = std::thread::hardware_concurrency());
+  ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+  ThreadPoolExecutor& operator=(const ThreadPoolExecutor&) = delete;
+  ~ThreadPoolExecutor() override;
+
+  void ParallelFor(size_t count,
+                   const std::function<void(size_t)>& task) override;
+  size_t Concurrency() const override;
+
+ private:
+  struct Job;
+
+  void WorkerLoop();
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable has_jobs_;
+  std::deque<std::shared_ptr<Job>> jobs_;
+  bool stopping_{false};
+};
+
+}  // namespace big_num_arithmetic
+
+#endif  // EXECUTOR_H_
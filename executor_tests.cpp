@@ -0,0 +1,95 @@
+#include "big_integer.h"
+#include "executor.h"
+#include <gtest/gtest.h>
+#include <atomic>
+
+namespace big_num_arithmetic {
+
+TEST(Test_27, ThreadPoolExecutor) {
+  ThreadPoolExecutor executor(4);
+  EXPECT_EQ(executor.Concurrency(), 4u);
+  {
+    std::vector<int> visited(1000, 0);
+    executor.ParallelFor(visited.size(), [&visited](size_t i) {
+      visited[i]++;
+    });
+    EXPECT_EQ(std::count(visited.begin(), visited.end(), 1), 1000);
+  }
+  {
+    std::atomic<int> calls{0};
+    executor.ParallelFor(16, [&executor, &calls](size_t) {
+      executor.ParallelFor(16, [&calls](size_t) { calls++; });
+    });
+    EXPECT_EQ(calls.load(), 256);
+  }
+  {
+    EXPECT_THROW(executor.ParallelFor(8, [](size_t i) {
+      if (i == 5) {
+        throw std::runtime_error("task failed");
+      }
+    }), std::runtime_error);
+  }
+  {
+    int calls = 0;
+    ParallelFor(nullptr, 3, [&calls](size_t) { calls++; });
+    EXPECT_EQ(calls, 3);
+  }
+}
+
+TEST(Test_28, ParallelReductions) {
+  ThreadPoolExecutor executor(4);
+  EXPECT_TRUE(BigInteger::Factorial(3000, &executor) ==
+              BigInteger::Factorial(3000));
+  EXPECT_TRUE(BigInteger::Binomial(5000, 1234, &executor) ==
+              BigInteger::Binomial(5000, 1234));
+  std::vector<BigInteger> values;
+  for (int64_t i = 1; i < 300; ++i) {
+    values.push_back(BigInteger(i * 7919 - 1000000));
+  }
+  EXPECT_TRUE(BigInteger::Product(values, &executor) ==
+              BigInteger::Product(values));
+}
+
+TEST(Test_29, ParallelMultiplicationAndDivision) {
+  std::vector<uint32_t> lhs(5000);
+  std::vector<uint32_t> rhs(2100);
+  uint32_t state = 777;
+  for (uint32_t& limb : lhs) {
+    state = state * 1103515245 + 12345;
+    limb = state;
+  }
+  for (uint32_t& limb : rhs) {
+    state = state * 1103515245 + 12345;
+    limb = state;
+  }
+  BigInteger numerator = BigInteger::FromLimbs(lhs.data(), lhs.size());
+  BigInteger divisor = BigInteger::FromLimbs(rhs.data(), rhs.size());
+  BigInteger product = numerator * divisor;
+  BigInteger quotient = numerator / divisor;
+  BigInteger remainder = numerator - quotient * divisor;
+  EXPECT_TRUE(remainder >= 0 && remainder < divisor);
+  EXPECT_TRUE(product / divisor == numerator);
+  EXPECT_TRUE((product + remainder) / numerator == divisor);
+
+  ThreadPoolExecutor executor(4);
+  BigInteger::SetExecutor(&executor);
+  EXPECT_TRUE(numerator * divisor == product);
+  EXPECT_TRUE(divisor * numerator == product);
+  EXPECT_TRUE(numerator / divisor == quotient);
+  EXPECT_TRUE(product / divisor == numerator);
+  BigInteger::SetExecutor(nullptr);
+}
+
+TEST(Test_36, ParallelPrimality) {
+  ThreadPoolExecutor executor(4);
+  BigInteger mersenne = (BigInteger(1) << 127) - 1;
+  EXPECT_TRUE(mersenne.IsProbablePrime(20, &executor));
+  EXPECT_FALSE((mersenne * 65537).IsProbablePrime(20, &executor));
+  EXPECT_FALSE(BigInteger(int64_t{3215031751}).IsProbablePrime(8, &executor));
+  BigInteger start = BigInteger(1) << 200;
+  EXPECT_TRUE(start.NextPrime(&executor) == start.NextPrime());
+  EXPECT_TRUE((BigInteger(1) << 64).NextPrime(&executor) ==
+              (BigInteger(1) << 64) + 13);
+}
+
+}  // namespace big_num_arithmetic
@@ -0,0 +1,149 @@
+#include "instrumentation.h"
+#include "limb_kernels.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+
+namespace big_num_arithmetic {
+
+namespace instrumentation {
+
+namespace {
+
+struct AtomicCounter {
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> limbs{0};
+  std::atomic<uint64_t> allocations{0};
+};
+
+AtomicCounter counters[kOperations][kSizeBands];
+
+const char* const kBandNames[kSizeBands] = {
+    "<16", "<256", "<4096", "<65536", ">=65536"};
+
+void PrintAtExit() {
+  Print(TakeSnapshot(), std::cerr);
+}
+
+}  // namespace
+
+const Counter& Snapshot::At(Operation operation, size_t band) const {
+  return counters.at(static_cast<size_t>(operation)).at(band);
+}
+
+Counter Snapshot::Total(Operation operation) const {
+  Counter total;
+  for (const Counter& counter : counters.at(static_cast<size_t>(operation))) {
+    total.calls += counter.calls;
+    total.limbs += counter.limbs;
+    total.allocations += counter.allocations;
+  }
+  return total;
+}
+
+size_t SizeBand(uint64_t limbs) {
+  if (limbs == 0) {
+    return 0;
+  }
+  return std::min<size_t>((std::bit_width(limbs) - 1) / 4, kSizeBands - 1);
+}
+
+const char* OperationName(Operation operation) {
+  switch (operation) {
+    case Operation::kSchoolbookMultiply:
+      return "schoolbook_multiply";
+    case Operation::kKaratsubaMultiply:
+      return "karatsuba_multiply";
+    case Operation::kParallelMultiply:
+      return "parallel_multiply";
+    case Operation::kDivide:
+      return "divide";
+    case Operation::kFromString:
+      return "from_string";
+    case Operation::kToString:
+      return "to_string";
+    case Operation::kSqrtIteration:
+      return "sqrt_iteration";
+  }
+  return "unknown";
+}
+
+Snapshot TakeSnapshot() {
+  Snapshot snapshot;
+  for (size_t operation = 0; operation < kOperations; ++operation) {
+    for (size_t band = 0; band < kSizeBands; ++band) {
+      const AtomicCounter& source = counters[operation][band];
+      Counter& counter = snapshot.counters[operation][band];
+      counter.calls = source.calls.load(std::memory_order_relaxed);
+      counter.limbs = source.limbs.load(std::memory_order_relaxed);
+      counter.allocations =
+          source.allocations.load(std::memory_order_relaxed);
+    }
+  }
+  return snapshot;
+}
+
+void Reset() {
+  for (auto& bands : counters) {
+    for (AtomicCounter& counter : bands) {
+      counter.calls.store(0, std::memory_order_relaxed);
+      counter.limbs.store(0, std::memory_order_relaxed);
+      counter.allocations.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+void Print(const Snapshot& snapshot, std::ostream& output) {
+  output << "operation size_band calls limbs allocations\n";
+  for (size_t operation = 0; operation < kOperations; ++operation) {
+    for (size_t band = 0; band < kSizeBands; ++band) {
+      const Counter& counter = snapshot.counters[operation][band];
+      if (counter.calls == 0 && counter.allocations == 0) {
+        continue;
+      }
+      output << OperationName(static_cast<Operation>(operation)) << ' '
+             << kBandNames[band] << ' ' << counter.calls << ' '
+             << counter.limbs << ' ' << counter.allocations << '\n';
+    }
+  }
+}
+
+void DumpAtExit() {
+  static std::once_flag registered;
+  std::call_once(registered, [] { std::atexit(PrintAtExit); });
+}
+
+void Record(Operation operation, uint64_t limbs, uint64_t allocations) {
+  AtomicCounter& counter =
+      counters[static_cast<size_t>(operation)][SizeBand(limbs)];
+  counter.calls.fetch_add(1, std::memory_order_relaxed);
+  counter.limbs.fetch_add(limbs, std::memory_order_relaxed);
+  counter.allocations.fetch_add(allocations, std::memory_order_relaxed);
+}
+
+void RecordAllocations(Operation operation, uint64_t limbs,
+                       uint64_t allocations) {
+  counters[static_cast<size_t>(operation)][SizeBand(limbs)]
+      .allocations.fetch_add(allocations, std::memory_order_relaxed);
+}
+
+void RecordMultiply(size_t lhs_size, size_t rhs_size) {
+  size_t shorter = std::min(lhs_size, rhs_size);
+  size_t half = (std::max(lhs_size, rhs_size) + 1) / 2;
+  Operation operation = Operation::kKaratsubaMultiply;
+  if (shorter < kernels::kKaratsubaThreshold) {
+    operation = Operation::kSchoolbookMultiply;
+  } else if (kernels::GetExecutor() != nullptr &&
+             std::min(shorter, half) >= kernels::kParallelThreshold) {
+    operation = Operation::kParallelMultiply;
+  }
+  // The digits of the product are the only buffer of the call itself.
+  Record(operation, lhs_size + rhs_size, 1);
+}
+
+}  // namespace instrumentation
+
+}  // namespace big_num_arithmetic
@@ -0,0 +1,115 @@
+#ifndef INSTRUMENTATION_H_
+#define INSTRUMENTATION_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <type_traits>
+
+namespace big_num_arithmetic {
+
+// Counters of the expensive operations, by operation and by size of the
+// operands. They are compiled in only with BIG_INTEGER_INSTRUMENTATION
+// defined (the CMake option of the same name); otherwise the counting
+// macros expand to nothing and every snapshot is empty.
+//
+// A counter keeps the number of calls, the digits of their operands and
+// the digit buffers they allocate. Scratch buffers of the Karatsuba steps
+// and of the recursive division are counted in the size band of the step
+// that allocates them. Counting is thread-safe.
+namespace instrumentation {
+
+#if defined(BIG_INTEGER_INSTRUMENTATION)
+constexpr bool kEnabled = true;
+#else
+constexpr bool kEnabled = false;
+#endif
+
+enum class Operation {
+  kSchoolbookMultiply,
+  kKaratsubaMultiply,
+  // Karatsuba products big enough to use the executor of SetExecutor().
+  kParallelMultiply,
+  kDivide,
+  kFromString,
+  kToString,
+  // One step of the binary search of equation_solver::helpers::Sqrt.
+  kSqrtIteration,
+};
+
+constexpr size_t kOperations = 7;
+
+// Operations on [0, 16), [16, 256), [256, 4096), [4096, 65536) and at
+// least 65536 digits of operands in total.
+constexpr size_t kSizeBands = 5;
+
+struct Counter {
+  uint64_t calls{0};
+  uint64_t limbs{0};
+  uint64_t allocations{0};
+};
+
+struct Snapshot {
+  std::array<std::array<Counter, kSizeBands>, kOperations> counters{};
+
+  const Counter& At(Operation operation, size_t band) const;
+  // Sum over all the size bands.
+  Counter Total(Operation operation) const;
+};
+
+size_t SizeBand(uint64_t limbs);
+const char* OperationName(Operation);
+
+Snapshot TakeSnapshot();
+void Reset();
+// A line for every operation and band that was used.
+void Print(const Snapshot&, std::ostream&);
+// Prints the counters to std::cerr when the program exits normally.
+void DumpAtExit();
+
+// Used by the macros below. The size band is the one of LIMBS.
+void Record(Operation, uint64_t limbs, uint64_t allocations);
+void RecordAllocations(Operation, uint64_t limbs, uint64_t allocations);
+// Picks the tier the same way as kernels::Multiply().
+void RecordMultiply(size_t lhs_size, size_t rhs_size);
+
+}  // namespace instrumentation
+
+}  // namespace big_num_arithmetic
+
+// The macros may be used in constexpr functions: nothing is counted
+// during constant evaluation.
+#if defined(BIG_INTEGER_INSTRUMENTATION)
+#define BIG_INTEGER_COUNT(operation, limbs, allocations)              \
+  do {                                                                 \
+    if (!std::is_constant_evaluated()) {                               \
+      ::big_num_arithmetic::instrumentation::Record(                   \
+          ::big_num_arithmetic::instrumentation::Operation::operation, \
+          (limbs), (allocations));                                     \
+    }                                                                  \
+  } while (false)
+#define BIG_INTEGER_COUNT_ALLOCATIONS(operation, limbs, allocations)  \
+  do {                                                                 \
+    if (!std::is_constant_evaluated()) {                               \
+      ::big_num_arithmetic::instrumentation::RecordAllocations(        \
+          ::big_num_arithmetic::instrumentation::Operation::operation, \
+          (limbs), (allocations));                                     \
+    }                                                                  \
+  } while (false)
+#define BIG_INTEGER_COUNT_MULTIPLY(lhs_size, rhs_size)                \
+  do {                                                                 \
+    if (!std::is_constant_evaluated()) {                               \
+      ::big_num_arithmetic::instrumentation::RecordMultiply(           \
+          (lhs_size), (rhs_size));                                     \
+    }                                                                  \
+  } while (false)
+#else
+#define BIG_INTEGER_COUNT(operation, limbs, allocations) \
+  static_cast<void>(0)
+#define BIG_INTEGER_COUNT_ALLOCATIONS(operation, limbs, allocations) \
+  static_cast<void>(0)
+#define BIG_INTEGER_COUNT_MULTIPLY(lhs_size, rhs_size) static_cast<void>(0)
+#endif
+
+#endif  // INSTRUMENTATION_H_
@@ -0,0 +1,60 @@
+#include "instrumentation.h"
+#include "big_integer.h"
+#include "equation_solver.h"
+#include <gtest/gtest.h>
+#include <sstream>
+
+namespace big_num_arithmetic {
+
+TEST(Test_38, OperationCounters) {
+  using instrumentation::Operation;
+  EXPECT_EQ(instrumentation::SizeBand(0), 0u);
+  EXPECT_EQ(instrumentation::SizeBand(15), 0u);
+  EXPECT_EQ(instrumentation::SizeBand(16), 1u);
+  EXPECT_EQ(instrumentation::SizeBand(4095), 2u);
+  EXPECT_EQ(instrumentation::SizeBand(uint64_t{1} << 40), 4u);
+
+  instrumentation::Reset();
+  BigInteger small = BigInteger::FromString("123456789012345678901234", 10);
+  BigInteger big = BigInteger(1) << 4000;
+  BigInteger product = small * small;
+  product = big * big;
+  product = product / small;
+  std::string text = small.ToString(16);
+  BigInteger root_1;
+  BigInteger root_2;
+  equation_solver::Solve(equation_solver::GenerateEquation(
+      BigInteger(1), BigInteger(3), BigInteger(-5)), root_1, root_2);
+  instrumentation::Snapshot snapshot = instrumentation::TakeSnapshot();
+
+  if (!instrumentation::kEnabled) {
+    // The counting is compiled out.
+    EXPECT_EQ(snapshot.Total(Operation::kSchoolbookMultiply).calls, 0u);
+    EXPECT_EQ(snapshot.Total(Operation::kDivide).calls, 0u);
+    return;
+  }
+  EXPECT_EQ(snapshot.At(Operation::kFromString, 0).calls, 1u);
+  EXPECT_EQ(snapshot.At(Operation::kFromString, 0).limbs, 3u);
+  EXPECT_EQ(snapshot.At(Operation::kToString, 0).calls, 1u);
+  EXPECT_GE(snapshot.At(Operation::kSchoolbookMultiply, 0).calls, 1u);
+  // 126 digits by 126 digits.
+  EXPECT_EQ(snapshot.At(Operation::kKaratsubaMultiply, 1).calls, 1u);
+  EXPECT_EQ(snapshot.At(Operation::kKaratsubaMultiply, 1).limbs, 252u);
+  EXPECT_GT(snapshot.Total(Operation::kKaratsubaMultiply).allocations, 1u);
+  EXPECT_GE(snapshot.Total(Operation::kDivide).calls, 2u);
+  EXPECT_GT(snapshot.Total(Operation::kDivide).allocations, 0u);
+  EXPECT_GT(snapshot.Total(Operation::kSqrtIteration).calls, 0u);
+
+  std::ostringstream output;
+  instrumentation::Print(snapshot, output);
+  EXPECT_NE(output.str().find("karatsuba_multiply <256 1 252"),
+            std::string::npos);
+  EXPECT_EQ(output.str().find("parallel_multiply"), std::string::npos);
+
+  instrumentation::Reset();
+  snapshot = instrumentation::TakeSnapshot();
+  EXPECT_EQ(snapshot.Total(Operation::kKaratsubaMultiply).calls, 0u);
+  EXPECT_EQ(snapshot.Total(Operation::kDivide).allocations, 0u);
+}
+
+}  // namespace big_num_arithmetic
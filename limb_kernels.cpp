@@ -0,0 +1,210 @@
+#include "limb_kernels.h"
+#include "executor.h"
+#include "instrumentation.h"
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace big_num_arithmetic {
+
+namespace kernels {
+
+namespace {
+
+std::atomic<Executor*> parallel_executor{nullptr};
+
+// Product of a long LHS and a short RHS: LHS is cut into pieces of the
+// size of RHS, so that every partial product is balanced.
+void UnbalancedMultiply(const uint32_t* lhs, size_t lhs_size,
+                        const uint32_t* rhs, size_t rhs_size,
+                        uint32_t* result) {
+  for (size_t i = 0; i < lhs_size + rhs_size; ++i) {
+    result[i] = 0;
+  }
+  size_t pieces = (lhs_size + rhs_size - 1) / rhs_size;
+  Executor* executor =
+      (rhs_size >= kParallelThreshold) ? GetExecutor() : nullptr;
+  BIG_INTEGER_COUNT_ALLOCATIONS(kKaratsubaMultiply, lhs_size + rhs_size,
+                                (executor == nullptr) ? 1 : pieces);
+  if (executor == nullptr) {
+    std::vector<uint32_t> partial(2 * rhs_size);
+    for (size_t offset = 0; offset < lhs_size; offset += rhs_size) {
+      size_t piece_size = std::min(rhs_size, lhs_size - offset);
+      Multiply(lhs + offset, piece_size, rhs, rhs_size, partial.data());
+      Add(result + offset, lhs_size + rhs_size - offset,
+          partial.data(), piece_size + rhs_size, result + offset);
+    }
+    return;
+  }
+
+  // The partial products overlap in the result, so they are taken in
+  // parallel into buffers of their own and summed afterwards.
+  std::vector<std::vector<uint32_t>> partials(pieces);
+  executor->ParallelFor(pieces, [&](size_t piece) {
+    size_t offset = piece * rhs_size;
+    size_t piece_size = std::min(rhs_size, lhs_size - offset);
+    partials[piece].resize(piece_size + rhs_size);
+    Multiply(lhs + offset, piece_size, rhs, rhs_size,
+             partials[piece].data());
+  });
+  for (size_t piece = 0; piece < pieces; ++piece) {
+    size_t offset = piece * rhs_size;
+    Add(result + offset, lhs_size + rhs_size - offset,
+        partials[piece].data(), partials[piece].size(), result + offset);
+  }
+}
+
+}  // namespace
+
+void SetExecutor(Executor* executor) {
+  parallel_executor.store(executor);
+}
+
+Executor* GetExecutor() {
+  return parallel_executor.load();
+}
+
+BIG_INTEGER_DISPATCHED
+void KaratsubaMultiply(const uint32_t* lhs, size_t lhs_size,
+                       const uint32_t* rhs, size_t rhs_size,
+                       uint32_t* result) {
+  if (lhs_size < rhs_size) {
+    std::swap(lhs, rhs);
+    std::swap(lhs_size, rhs_size);
+  }
+  if (rhs_size < kKaratsubaThreshold) {
+    SchoolbookMultiply(lhs, lhs_size, rhs, rhs_size, result);
+    return;
+  }
+  size_t half = (lhs_size + 1) / 2;
+  if (rhs_size <= half) {
+    UnbalancedMultiply(lhs, lhs_size, rhs, rhs_size, result);
+    return;
+  }
+
+  // LHS = high_1 * B^half + low_1, RHS = high_2 * B^half + low_2, then
+  // LHS * RHS = high * B^(2 half) + middle * B^half + low, where
+  // middle = (low_1 + high_1)(low_2 + high_2) - high - low.
+  BIG_INTEGER_COUNT_ALLOCATIONS(kKaratsubaMultiply, lhs_size + rhs_size, 3);
+  size_t high_size = lhs_size + rhs_size - 2 * half;
+  std::vector<uint32_t> lhs_sum(half + 1);
+  std::vector<uint32_t> rhs_sum(half + 1);
+  lhs_sum[half] = Add(lhs, half, lhs + half, lhs_size - half, lhs_sum.data());
+  rhs_sum[half] = Add(rhs, half, rhs + half, rhs_size - half, rhs_sum.data());
+  std::vector<uint32_t> middle(2 * half + 2);
+
+  // The three products are independent, so they may run in parallel.
+  Executor* executor = (half >= kParallelThreshold) ? GetExecutor() : nullptr;
+  ParallelFor(executor, 3, [&](size_t product) {
+    if (product == 0) {
+      Multiply(lhs, half, rhs, half, result);
+    } else if (product == 1) {
+      Multiply(lhs + half, lhs_size - half, rhs + half, rhs_size - half,
+               result + 2 * half);
+    } else {
+      Multiply(lhs_sum.data(), half + 1, rhs_sum.data(), half + 1,
+               middle.data());
+    }
+  });
+
+  Subtract(middle.data(), middle.size(), result, 2 * half, middle.data());
+  Subtract(middle.data(), middle.size(), result + 2 * half, high_size,
+           middle.data());
+  Add(result + half, lhs_size + rhs_size - half, middle.data(),
+      Normalize(middle.data(), middle.size()), result + half);
+}
+
+void SchoolbookDivide(uint32_t* numerator, size_t numerator_size,
+                      const uint32_t* divisor, size_t divisor_size,
+                      uint32_t* quotient) {
+  SchoolbookDivide(numerator, numerator_size, divisor, divisor_size,
+                   Reciprocal(divisor[divisor_size - 1]), quotient);
+}
+
+BIG_INTEGER_DISPATCHED
+void SchoolbookDivide(uint32_t* numerator, size_t numerator_size,
+                      const uint32_t* divisor, size_t divisor_size,
+                      uint32_t reciprocal, uint32_t* quotient) {
+  const uint64_t kBase = uint64_t{1} << 32;
+  uint32_t divisor_high = divisor[divisor_size - 1];
+  uint64_t divisor_next = divisor[divisor_size - 2];
+  for (size_t j = numerator_size - divisor_size; j-- > 0;) {
+    uint32_t* window = numerator + j;
+    // Estimate the digit by the three highest digits of the window; the
+    // estimate is at most one too large after the correction below. The
+    // highest digit of the window is at most divisor_high.
+    uint64_t digit;
+    uint64_t rest;
+    if (window[divisor_size] == divisor_high) {
+      digit = kBase - 1;
+      rest = uint64_t{window[divisor_size - 1]} + divisor_high;
+    } else {
+      uint32_t remainder;
+      digit = DivideByReciprocal(window[divisor_size],
+                                 window[divisor_size - 1], divisor_high,
+                                 reciprocal, remainder);
+      rest = remainder;
+    }
+    while (rest < kBase &&
+           digit * divisor_next > ((rest << 32) | window[divisor_size - 2])) {
+      --digit;
+      rest += divisor_high;
+    }
+
+    // window -= digit * DIVISOR
+    int64_t borrow = 0;
+    for (size_t i = 0; i < divisor_size; ++i) {
+      uint64_t product = digit * divisor[i];
+      int64_t difference = int64_t{window[i]} - borrow -
+          static_cast<int64_t>(product & 0xffffffff);
+      window[i] = static_cast<uint32_t>(difference);
+      borrow = static_cast<int64_t>(product >> 32) - (difference >> 32);
+    }
+    int64_t difference = int64_t{window[divisor_size]} - borrow;
+    window[divisor_size] = static_cast<uint32_t>(difference);
+
+    if (difference < 0) {
+      // The estimate was one too large, add DIVISOR back.
+      --digit;
+      uint64_t carry = 0;
+      for (size_t i = 0; i < divisor_size; ++i) {
+        carry += uint64_t{window[i]} + divisor[i];
+        window[i] = static_cast<uint32_t>(carry);
+        carry >>= 32;
+      }
+      window[divisor_size] += static_cast<uint32_t>(carry);
+    }
+    quotient[j] = static_cast<uint32_t>(digit);
+  }
+}
+
+BIG_INTEGER_DISPATCHED
+void DivideExact(uint32_t* numerator, size_t quotient_size,
+                 const uint32_t* divisor, size_t divisor_size,
+                 uint32_t* quotient) {
+  uint32_t inverse = InverseModBase(divisor[0]);
+  for (size_t i = 0; i < quotient_size; ++i) {
+    uint32_t digit = numerator[i] * inverse;
+    // numerator -= digit * DIVISOR * B^i, below B^quotient_size only; the
+    // lowest digit becomes zero.
+    size_t count = std::min(divisor_size, quotient_size - i);
+    uint64_t borrow = 0;
+    for (size_t j = 0; j < count; ++j) {
+      uint64_t product = uint64_t{digit} * divisor[j] + borrow;
+      uint32_t low = static_cast<uint32_t>(product);
+      uint32_t current = numerator[i + j];
+      numerator[i + j] = current - low;
+      borrow = (product >> 32) + (current < low ? 1 : 0);
+    }
+    for (size_t j = i + count; borrow != 0 && j < quotient_size; ++j) {
+      uint64_t current = numerator[j];
+      numerator[j] = static_cast<uint32_t>(current - borrow);
+      borrow = (current < borrow) ? 1 : 0;
+    }
+    quotient[i] = digit;
+  }
+}
+
+}  // namespace kernels
+
+}  // namespace big_num_arithmetic
@@ -0,0 +1,266 @@
+#ifndef LIMB_KERNELS_H_
+#define LIMB_KERNELS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// With BIG_INTEGER_DISPATCH (see CMakeLists.txt) the loops that only run
+// at run time are compiled for x86-64-v3 (AVX2, BMI2) and for the baseline
+// processor, and the loader picks one of them for the machine.
+#if defined(BIG_INTEGER_DISPATCH)
+#define BIG_INTEGER_DISPATCHED \
+  __attribute__((target_clones("arch=x86-64-v3", "default")))
+#else
+#define BIG_INTEGER_DISPATCHED
+#endif
+
+namespace big_num_arithmetic {
+
+class Executor;
+
+// Loops over raw digits of BigInteger::internal_base (2^32), the lowest
+// digit first. They know nothing about signs or ownership, so they are
+// shared by BigInteger and the containers that keep digits elsewhere.
+namespace kernels {
+
+// Returns the size of the number without its leading zero digits.
+constexpr size_t Normalize(const uint32_t* digits, size_t size) {
+  while (size > 0 && digits[size - 1] == 0) {
+    --size;
+  }
+  return size;
+}
+
+// Returns -1, 0 or 1 comparing |LHS| and |RHS|, which must be normalized.
+constexpr int Compare(const uint32_t* lhs, size_t lhs_size,
+                      const uint32_t* rhs, size_t rhs_size) {
+  if (lhs_size != rhs_size) {
+    return (lhs_size < rhs_size) ? -1 : 1;
+  }
+  for (size_t i = lhs_size; i-- > 0;) {
+    if (lhs[i] != rhs[i]) {
+      return (lhs[i] < rhs[i]) ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+// Writes lhs_size digits of LHS + RHS to result and returns the carry.
+// Requires lhs_size >= rhs_size; result may be the same array as LHS.
+constexpr uint32_t Add(const uint32_t* lhs, size_t lhs_size,
+                       const uint32_t* rhs, size_t rhs_size,
+                       uint32_t* result) {
+  uint64_t carry = 0;
+  for (size_t i = 0; i < rhs_size; ++i) {
+    carry += uint64_t{lhs[i]} + rhs[i];
+    result[i] = static_cast<uint32_t>(carry);
+    carry >>= 32;
+  }
+  for (size_t i = rhs_size; i < lhs_size; ++i) {
+    carry += lhs[i];
+    result[i] = static_cast<uint32_t>(carry);
+    carry >>= 32;
+  }
+  return static_cast<uint32_t>(carry);
+}
+
+// Writes lhs_size digits of LHS - RHS to result; if |LHS| < |RHS|, the
+// difference wraps modulo 2^(32 lhs_size). Result may be the same array
+// as LHS.
+constexpr void Subtract(const uint32_t* lhs, size_t lhs_size,
+                        const uint32_t* rhs, size_t rhs_size,
+                        uint32_t* result) {
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < lhs_size; ++i) {
+    uint64_t subtrahend = ((i < rhs_size) ? rhs[i] : 0) + borrow;
+    borrow = (lhs[i] < subtrahend) ? 1 : 0;
+    result[i] = static_cast<uint32_t>((borrow << 32) + lhs[i] - subtrahend);
+  }
+}
+
+// Writes size digits of VALUE * 2^shift to result and returns the bits
+// shifted out of the highest digit; 0 <= shift < 32. Result may be VALUE.
+constexpr uint32_t ShiftLeft(const uint32_t* value, size_t size,
+                             unsigned shift, uint32_t* result) {
+  uint32_t carry = 0;
+  for (size_t i = 0; i < size; ++i) {
+    uint32_t digit = value[i];
+    result[i] = (shift == 0) ? digit : (digit << shift) | carry;
+    carry = (shift == 0) ? 0 : digit >> (32 - shift);
+  }
+  return carry;
+}
+
+// Writes size digits of VALUE / 2^shift to result, 0 <= shift < 32.
+// Result may be VALUE.
+constexpr void ShiftRight(const uint32_t* value, size_t size,
+                          unsigned shift, uint32_t* result) {
+  for (size_t i = 0; i < size; ++i) {
+    uint32_t high = (i + 1 < size) ? value[i + 1] : 0;
+    result[i] = (shift == 0) ? value[i]
+                             : (value[i] >> shift) | (high << (32 - shift));
+  }
+}
+
+// Returns VALUE mod DIVISOR for a single-digit DIVISOR > 0.
+constexpr uint32_t RemainderByDigit(const uint32_t* value, size_t size,
+                                    uint32_t divisor) {
+  uint64_t remainder = 0;
+  for (size_t i = size; i-- > 0;) {
+    remainder = ((remainder << 32) | value[i]) % divisor;
+  }
+  return static_cast<uint32_t>(remainder);
+}
+
+// DIGIT^-1 mod 2^32 for an odd DIGIT. Newton's iteration doubles the
+// number of correct low bits, and any odd number is its own inverse
+// modulo 2^3.
+constexpr uint32_t InverseModBase(uint32_t digit) {
+  uint32_t inverse = digit;
+  for (int i = 0; i < 4; ++i) {
+    inverse *= 2 - digit * inverse;
+  }
+  return inverse;
+}
+
+// floor((2^64 - 1) / DIGIT) - 2^32 for a DIGIT with the highest bit set,
+// the reciprocal that DivideByReciprocal() takes.
+constexpr uint32_t Reciprocal(uint32_t digit) {
+  return static_cast<uint32_t>(UINT64_MAX / digit - (uint64_t{1} << 32));
+}
+
+// (HIGH 2^32 + LOW) / DIVISOR for HIGH < DIVISOR and a DIVISOR with the
+// highest bit set, by two multiplications instead of a division
+// (algorithm 4 of "Improved division by invariant integers" by Moller and
+// Granlund). All the arithmetic is modulo 2^64 and 2^32 on purpose.
+constexpr uint32_t DivideByReciprocal(uint32_t high, uint32_t low,
+                                      uint32_t divisor, uint32_t reciprocal,
+                                      uint32_t& remainder) {
+  uint64_t product = uint64_t{reciprocal} * high +
+      ((uint64_t{high} << 32) | low);
+  uint32_t quotient = static_cast<uint32_t>(product >> 32) + 1;
+  uint32_t rest = low - quotient * divisor;
+  if (rest > static_cast<uint32_t>(product)) {
+    --quotient;
+    rest += divisor;
+  }
+  if (rest >= divisor) {
+    ++quotient;
+    rest -= divisor;
+  }
+  remainder = rest;
+  return quotient;
+}
+
+// Folds the 128-bit product of LHS and RHS into 64 bits, the mixing step
+// of wyhash.
+constexpr uint64_t MixWords(uint64_t lhs, uint64_t rhs) {
+  unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+  return static_cast<uint64_t>(product) ^
+      static_cast<uint64_t>(product >> 64);
+}
+
+// Hash of the digits in the manner of wyhash: four digits per mixing
+// step, the tail padded with zeros, and the size in the last step.
+constexpr uint64_t Hash(const uint32_t* digits, size_t size, uint64_t seed) {
+  constexpr uint64_t kSecret[3] = {0xa0761d6478bd642f, 0xe7037ed1a0b428db,
+                                   0x8ebc6af09c88c6e3};
+  uint64_t state = MixWords(seed ^ kSecret[0], kSecret[1]);
+  size_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    uint64_t low = (uint64_t{digits[i + 1]} << 32) | digits[i];
+    uint64_t high = (uint64_t{digits[i + 3]} << 32) | digits[i + 2];
+    state = MixWords(low ^ kSecret[1], high ^ state);
+  }
+  uint64_t tail[2] = {0, 0};
+  for (size_t j = i; j < size; ++j) {
+    tail[(j - i) / 2] |= uint64_t{digits[j]} << (32 * ((j - i) % 2));
+  }
+  state = MixWords(tail[0] ^ kSecret[1], tail[1] ^ state);
+  return MixWords(state ^ kSecret[2], size ^ kSecret[0]);
+}
+
+// Below this size of the shorter factor the schoolbook product is faster
+// than splitting the factors.
+constexpr size_t kKaratsubaThreshold = 32;
+
+// Writes lhs_size + rhs_size digits of LHS * RHS to result, which must not
+// overlap the arguments. It takes O(lhs_size * rhs_size) operations.
+constexpr void SchoolbookMultiply(const uint32_t* lhs, size_t lhs_size,
+                                  const uint32_t* rhs, size_t rhs_size,
+                                  uint32_t* result) {
+  for (size_t i = 0; i < lhs_size + rhs_size; ++i) {
+    result[i] = 0;
+  }
+  for (size_t i = 0; i < rhs_size; ++i) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < lhs_size; ++j) {
+      carry += result[i + j] + uint64_t{rhs[i]} * lhs[j];
+      result[i + j] = static_cast<uint32_t>(carry);
+      carry >>= 32;
+    }
+    result[i + lhs_size] = static_cast<uint32_t>(carry);
+  }
+}
+
+// The same product by the Karatsuba method, O(n^1.59) for n-digit factors.
+// Defined in limb_kernels.cpp, as it needs scratch memory.
+void KaratsubaMultiply(const uint32_t* lhs, size_t lhs_size,
+                       const uint32_t* rhs, size_t rhs_size,
+                       uint32_t* result);
+
+// Karatsuba steps whose halves have at least this many digits run their
+// three products on the executor set by SetExecutor().
+constexpr size_t kParallelThreshold = 1024;
+
+// Executor for the products of big operands; nullptr, the default, keeps
+// all of them on the calling thread. The executor must outlive its use.
+void SetExecutor(Executor*);
+Executor* GetExecutor();
+
+// Writes lhs_size + rhs_size digits of LHS * RHS to result, which must not
+// overlap the arguments, choosing the method by the size of the factors.
+constexpr void Multiply(const uint32_t* lhs, size_t lhs_size,
+                        const uint32_t* rhs, size_t rhs_size,
+                        uint32_t* result) {
+  if (!std::is_constant_evaluated() &&
+      std::min(lhs_size, rhs_size) >= kKaratsubaThreshold) {
+    KaratsubaMultiply(lhs, lhs_size, rhs, rhs_size, result);
+    return;
+  }
+  SchoolbookMultiply(lhs, lhs_size, rhs, rhs_size, result);
+}
+
+// Divides NUMERATOR by DIVISOR with the Knuth algorithm D in
+// O(divisor_size * quotient size) operations. DIVISOR must have at least two
+// digits and the highest bit of its highest digit set, and the highest
+// digit of NUMERATOR must be zero. Writes numerator_size - divisor_size
+// digits of the quotient to quotient and leaves the remainder in the lowest
+// divisor_size digits of NUMERATOR.
+void SchoolbookDivide(uint32_t* numerator, size_t numerator_size,
+                      const uint32_t* divisor, size_t divisor_size,
+                      uint32_t* quotient);
+// The same with Reciprocal() of the highest digit of DIVISOR computed in
+// advance.
+void SchoolbookDivide(uint32_t* numerator, size_t numerator_size,
+                      const uint32_t* divisor, size_t divisor_size,
+                      uint32_t reciprocal, uint32_t* quotient);
+
+// Divides NUMERATOR by an odd DIVISOR that divides it exactly, from the
+// lowest digit up (Jebelean's exact division): each quotient digit is the
+// lowest digit left times the inverse of divisor[0] modulo 2^32, so no
+// digit is estimated or corrected, and digits above quotient_size are
+// never touched. Writes quotient_size digits of the quotient and
+// overwrites the lowest quotient_size digits of NUMERATOR; quotient may
+// be NUMERATOR.
+void DivideExact(uint32_t* numerator, size_t quotient_size,
+                 const uint32_t* divisor, size_t divisor_size,
+                 uint32_t* quotient);
+
+}  // namespace kernels
+
+}  // namespace big_num_arithmetic
+
+#endif  // LIMB_KERNELS_H_
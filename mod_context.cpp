@@ -0,0 +1,230 @@
+#include "mod_context.h"
+#include "limb_kernels.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace big_num_arithmetic {
+
+ModContext::ModContext(const BigInteger& modulus)
+    : modulus_(modulus), size_(modulus.Limbs().size()) {
+  if (modulus.Sign() <= 0) {
+    throw std::invalid_argument("Non-positive modulus");
+  }
+  montgomery_ = (modulus.Limbs()[0] & 1) != 0;
+  lhs_.resize(size_);
+  rhs_.resize(size_);
+  product_.resize(2 * size_ + 2);
+  quotient_.resize(2 * size_ + 2);
+  multiple_.resize(2 * size_ + 2);
+  table_.resize((size_t{1} << kWindowBits) * size_);
+  one_.resize(size_);
+
+  BigInteger power = BigInteger(1) << (64 * size_);
+  if (montgomery_) {
+    inverse_ = 0 - kernels::InverseModBase(modulus.Limbs()[0]);
+    constant_.resize(size_);
+    Load(power - power / modulus_ * modulus_, constant_.data());
+    // The residue of 1 is R = R^2 * R^-1.
+    std::fill(rhs_.begin(), rhs_.end(), 0);
+    rhs_[0] = 1;
+    Multiply(rhs_.data(), constant_.data(), one_.data());
+  } else {
+    // floor((B^(2n) - 1) / m) fits into n + 1 digits even for m = B^(n-1),
+    // and differs from floor(B^(2n) / m) by at most 1.
+    BigInteger reciprocal = (power - 1) / modulus_;
+    constant_.assign(size_ + 1, 0);
+    std::copy(reciprocal.Limbs().begin(), reciprocal.Limbs().end(),
+              constant_.begin());
+    one_[0] = 1;
+  }
+}
+
+const BigInteger& ModContext::Modulus() const {
+  return modulus_;
+}
+
+bool ModContext::IsMontgomery() const {
+  return montgomery_;
+}
+
+// HELP-FUNCTIONS
+
+void ModContext::Load(const BigInteger& residue, uint32_t* digits) const {
+  if (residue.Sign() < 0 || residue >= modulus_) {
+    throw std::out_of_range("Residue out of range");
+  }
+  const std::vector<uint32_t>& limbs = residue.Limbs();
+  std::copy(limbs.begin(), limbs.end(), digits);
+  std::fill(digits + limbs.size(), digits + size_, 0);
+}
+
+void ModContext::Store(const uint32_t* digits, size_t size,
+                       BigInteger& result) {
+  result.digits_.assign(digits, digits + kernels::Normalize(digits, size));
+  result.sign_ = result.digits_.empty() ? 0 : 1;
+}
+
+bool ModContext::Subtract(uint32_t* value) const {
+  const uint32_t* modulus = modulus_.Limbs().data();
+  if (kernels::Compare(value, kernels::Normalize(value, size_ + 1),
+                       modulus, size_) < 0) {
+    return false;
+  }
+  kernels::Subtract(value, size_ + 1, modulus, size_, value);
+  return true;
+}
+
+void ModContext::Multiply(const uint32_t* lhs, const uint32_t* rhs,
+                          uint32_t* result) {
+  kernels::Multiply(lhs, size_, rhs, size_, product_.data());
+  product_[2 * size_] = 0;
+  product_[2 * size_ + 1] = 0;
+  if (montgomery_) {
+    MontgomeryReduce(result);
+  } else {
+    BarrettReduce(result);
+  }
+}
+
+BIG_INTEGER_DISPATCHED
+void ModContext::MontgomeryReduce(uint32_t* result) {
+  // Every step adds a multiple of m that clears the lowest digit left, so
+  // after size_ steps the product is divisible by R and is below 2 m R.
+  const uint32_t* modulus = modulus_.Limbs().data();
+  uint32_t* product = product_.data();
+  for (size_t i = 0; i < size_; ++i) {
+    uint64_t factor = static_cast<uint32_t>(product[i] * inverse_);
+    uint64_t carry = 0;
+    for (size_t j = 0; j < size_; ++j) {
+      carry += product[i + j] + factor * modulus[j];
+      product[i + j] = static_cast<uint32_t>(carry);
+      carry >>= 32;
+    }
+    for (size_t j = i + size_; carry != 0; ++j) {
+      carry += product[j];
+      product[j] = static_cast<uint32_t>(carry);
+      carry >>= 32;
+    }
+  }
+  Subtract(product + size_);
+  std::copy(product + size_, product + 2 * size_, result);
+}
+
+void ModContext::BarrettReduce(uint32_t* result) {
+  // Handbook of Applied Cryptography, algorithm 14.42: with
+  // q = floor(floor(x / B^(n - 1)) * mu / B^(n + 1)) the remainder
+  // x - q m is below 3 m (4 m with the rounded down mu), so it is found
+  // modulo B^(n + 1).
+  const uint32_t* modulus = modulus_.Limbs().data();
+  uint32_t* product = product_.data();
+  kernels::Multiply(product + size_ - 1, size_ + 1, constant_.data(),
+                    size_ + 1, quotient_.data());
+  kernels::Multiply(quotient_.data() + size_ + 1, size_ + 1, modulus, size_,
+                    multiple_.data());
+  // Both are taken modulo B^(n + 1), so the borrow out is dropped.
+  kernels::Subtract(product, size_ + 1, multiple_.data(), size_ + 1,
+                    product);
+  while (Subtract(product)) {
+  }
+  std::copy(product, product + size_, result);
+}
+
+// MODULAR OPERATIONS
+
+BigInteger ModContext::ToResidue(const BigInteger& value) {
+  BigInteger residue = value - value / modulus_ * modulus_;
+  if (residue.Sign() < 0) {
+    residue += modulus_;
+  }
+  if (montgomery_) {
+    // x R = (x * R^2) * R^-1.
+    Load(residue, lhs_.data());
+    Multiply(lhs_.data(), constant_.data(), lhs_.data());
+    Store(lhs_.data(), size_, residue);
+  }
+  return residue;
+}
+
+BigInteger ModContext::FromResidue(const BigInteger& residue) {
+  Load(residue, lhs_.data());
+  if (!montgomery_) {
+    return residue;
+  }
+  std::fill(rhs_.begin(), rhs_.end(), 0);
+  rhs_[0] = 1;
+  Multiply(lhs_.data(), rhs_.data(), lhs_.data());
+  BigInteger value;
+  Store(lhs_.data(), size_, value);
+  return value;
+}
+
+void ModContext::MulMod(const BigInteger& big_int_lhs,
+                        const BigInteger& big_int_rhs, BigInteger& result) {
+  Load(big_int_lhs, lhs_.data());
+  Load(big_int_rhs, rhs_.data());
+  Multiply(lhs_.data(), rhs_.data(), lhs_.data());
+  Store(lhs_.data(), size_, result);
+}
+
+void ModContext::AddMod(const BigInteger& big_int_lhs,
+                        const BigInteger& big_int_rhs, BigInteger& result) {
+  Load(big_int_lhs, lhs_.data());
+  Load(big_int_rhs, rhs_.data());
+  product_[size_] = kernels::Add(lhs_.data(), size_, rhs_.data(), size_,
+                                 product_.data());
+  Subtract(product_.data());
+  Store(product_.data(), size_, result);
+}
+
+void ModContext::SubMod(const BigInteger& big_int_lhs,
+                        const BigInteger& big_int_rhs, BigInteger& result) {
+  Load(big_int_lhs, lhs_.data());
+  Load(big_int_rhs, rhs_.data());
+  product_[size_] = 0;
+  std::copy(lhs_.begin(), lhs_.end(), product_.begin());
+  if (big_int_lhs < big_int_rhs) {
+    product_[size_] = kernels::Add(product_.data(), size_,
+                                   modulus_.Limbs().data(), size_,
+                                   product_.data());
+  }
+  kernels::Subtract(product_.data(), size_ + 1, rhs_.data(), size_,
+                    product_.data());
+  Store(product_.data(), size_, result);
+}
+
+BigInteger ModContext::PowMod(const BigInteger& base,
+                              const BigInteger& exponent) {
+  BigInteger residue = (exponent.Sign() < 0)
+      ? ToResidue(BigInteger::ModInverse(base, modulus_))
+      : ToResidue(base);
+
+  // table_ holds residues of BASE^0, ..., BASE^15.
+  std::copy(one_.begin(), one_.end(), table_.begin());
+  Load(residue, table_.data() + size_);
+  for (size_t i = 2; i < (size_t{1} << kWindowBits); ++i) {
+    Multiply(table_.data() + (i - 1) * size_, table_.data() + size_,
+             table_.data() + i * size_);
+  }
+
+  const std::vector<uint32_t>& digits = exponent.Limbs();
+  size_t windows = (exponent.BitLength() + kWindowBits - 1) / kWindowBits;
+  uint32_t* power = lhs_.data();
+  std::copy(one_.begin(), one_.end(), power);
+  for (size_t window = windows; window-- > 0;) {
+    if (window + 1 != windows) {
+      for (unsigned i = 0; i < kWindowBits; ++i) {
+        Multiply(power, power, power);
+      }
+    }
+    size_t bit = window * kWindowBits;
+    uint32_t index = (digits[bit / 32] >> (bit % 32)) &
+        ((uint32_t{1} << kWindowBits) - 1);
+    if (index != 0) {
+      Multiply(power, table_.data() + index * size_, power);
+    }
+  }
+  Store(power, size_, residue);
+  return FromResidue(residue);
+}
+
+}  // namespace big_num_arithmetic
@@ -0,0 +1,82 @@
+#ifndef MOD_CONTEXT_H_
+#define MOD_CONTEXT_H_
+
+#include "big_integer.h"
+#include <vector>
+
+namespace big_num_arithmetic {
+
+// Arithmetic modulo a fixed modulus m. The constants of the reduction are
+// computed once: Montgomery's for an odd modulus, Barrett's for an even
+// one. Every operation works on digit arrays of the size of m that the
+// context keeps, so it needs no allocation of its own; only products of
+// moduli longer than kernels::kKaratsubaThreshold digits allocate inside
+// the Karatsuba method. One context must not be used by several threads
+// at the same time.
+//
+// MulMod(), AddMod() and SubMod() take residues in the form of the context
+// (x R mod m with R = 2^(32 n) for Montgomery, x itself for Barrett),
+// which ToResidue() and FromResidue() convert to and from. They must be
+// in [0, m), std::out_of_range is thrown otherwise.
+class ModContext {
+ public:
+  // Throws std::invalid_argument if the modulus is not positive.
+  explicit ModContext(const BigInteger& modulus);
+
+  const BigInteger& Modulus() const;
+  bool IsMontgomery() const;
+
+  // Residue of any integer, negative ones included.
+  BigInteger ToResidue(const BigInteger&);
+  BigInteger FromResidue(const BigInteger&);
+
+  // The result may be one of the arguments. Its digits are reused, so a
+  // result of the previous call keeps the operation free of allocations.
+  void MulMod(const BigInteger&, const BigInteger&, BigInteger& result);
+  void AddMod(const BigInteger&, const BigInteger&, BigInteger& result);
+  void SubMod(const BigInteger&, const BigInteger&, BigInteger& result);
+
+  // BASE^EXPONENT mod m for ordinary integers, by windows of four bits.
+  // A negative exponent takes the power of the inverse of BASE, which
+  // throws std::runtime_error if there is none.
+  BigInteger PowMod(const BigInteger& base, const BigInteger& exponent);
+
+ private:
+  static constexpr unsigned kWindowBits = 4;
+
+  // Copies the digits of a residue to size_ digits, padded with zeros.
+  void Load(const BigInteger&, uint32_t*) const;
+  // Writes size_ digits to result, reusing its storage.
+  static void Store(const uint32_t*, size_t, BigInteger& result);
+
+  // result = LHS * RHS * R^-1 mod m for Montgomery, LHS * RHS mod m
+  // for Barrett; all have size_ digits, result may be LHS or RHS.
+  void Multiply(const uint32_t* lhs, const uint32_t* rhs, uint32_t* result);
+  // Reduces the 2 size_ + 1 digits of product_.
+  void MontgomeryReduce(uint32_t* result);
+  void BarrettReduce(uint32_t* result);
+  // VALUE -= m, if VALUE >= m; VALUE has size_ + 1 digits. Returns
+  // whether m was subtracted.
+  bool Subtract(uint32_t* value) const;
+
+  BigInteger modulus_;
+  size_t size_;
+  bool montgomery_;
+  // -m^-1 mod 2^32 for Montgomery.
+  uint32_t inverse_{0};
+  // R^2 mod m for Montgomery, floor((2^(64 n) - 1) / m) for Barrett.
+  std::vector<uint32_t> constant_;
+  std::vector<uint32_t> one_;
+
+  // Scratch memory, allocated once by the constructor.
+  std::vector<uint32_t> lhs_;
+  std::vector<uint32_t> rhs_;
+  std::vector<uint32_t> product_;
+  std::vector<uint32_t> quotient_;
+  std::vector<uint32_t> multiple_;
+  std::vector<uint32_t> table_;
+};
+
+}  // namespace big_num_arithmetic
+
+#endif  // MOD_CONTEXT_H_
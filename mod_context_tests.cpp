@@ -0,0 +1,87 @@
+#include "mod_context.h"
+#include <gtest/gtest.h>
+
+namespace big_num_arithmetic {
+
+namespace {
+
+// x mod m in [0, m), by the definition.
+BigInteger Remainder(const BigInteger& value, const BigInteger& modulus) {
+  BigInteger remainder = value - value / modulus * modulus;
+  return (remainder < 0) ? remainder + modulus : remainder;
+}
+
+}  // namespace
+
+TEST(Test_33, ModContextArithmetic) {
+  BigInteger big = BigInteger::FromString(
+      "170141183460469231731687303715884105727", 10);
+  for (const BigInteger& modulus : {big, big + 1, BigInteger(1) << 64,
+                                    BigInteger(97), BigInteger(1)}) {
+    ModContext context(modulus);
+    EXPECT_EQ(context.IsMontgomery(), modulus.Limbs()[0] % 2 == 1);
+    BigInteger lhs = BigInteger::Factorial(40) + 11;
+    BigInteger rhs = -BigInteger::Factorial(35) - 7;
+    BigInteger lhs_residue = context.ToResidue(lhs);
+    BigInteger rhs_residue = context.ToResidue(rhs);
+    EXPECT_TRUE(context.FromResidue(lhs_residue) == Remainder(lhs, modulus));
+
+    BigInteger result;
+    context.MulMod(lhs_residue, rhs_residue, result);
+    EXPECT_TRUE(context.FromResidue(result) == Remainder(lhs * rhs, modulus));
+    context.AddMod(lhs_residue, rhs_residue, result);
+    EXPECT_TRUE(context.FromResidue(result) == Remainder(lhs + rhs, modulus));
+    context.SubMod(lhs_residue, rhs_residue, result);
+    EXPECT_TRUE(context.FromResidue(result) == Remainder(lhs - rhs, modulus));
+    context.SubMod(rhs_residue, lhs_residue, result);
+    EXPECT_TRUE(context.FromResidue(result) == Remainder(rhs - lhs, modulus));
+    context.MulMod(result, result, result);
+    EXPECT_TRUE(context.FromResidue(result) ==
+                Remainder((rhs - lhs) * (rhs - lhs), modulus));
+  }
+  {
+    ModContext context(BigInteger(97));
+    BigInteger result;
+    EXPECT_THROW(context.MulMod(BigInteger(97), BigInteger(1), result),
+                 std::out_of_range);
+    EXPECT_THROW(context.AddMod(BigInteger(-1), BigInteger(1), result),
+                 std::out_of_range);
+    EXPECT_THROW(ModContext(BigInteger(0)), std::invalid_argument);
+    EXPECT_THROW(ModContext(BigInteger(-5)), std::invalid_argument);
+  }
+}
+
+TEST(Test_34, PowMod) {
+  {
+    ModContext context(BigInteger(1000000007));
+    EXPECT_TRUE(context.PowMod(BigInteger(2), BigInteger(10)) == 1024);
+    EXPECT_TRUE(context.PowMod(BigInteger(5), BigInteger(0)) == 1);
+    EXPECT_TRUE(context.PowMod(BigInteger(0), BigInteger(0)) == 1);
+    EXPECT_TRUE(context.PowMod(BigInteger(-2), BigInteger(3)) == 999999999);
+    // Fermat's little theorem: 3^(p - 2) is the inverse of 3.
+    EXPECT_TRUE(context.PowMod(BigInteger(3), BigInteger(-1)) ==
+                context.PowMod(BigInteger(3), BigInteger(1000000005)));
+  }
+  {
+    // 2^521 - 1 is prime, so a^(p - 1) = 1 for any a not divisible by it.
+    BigInteger prime = (BigInteger(1) << 521) - 1;
+    ModContext context(prime);
+    BigInteger base = BigInteger::Factorial(200);
+    EXPECT_TRUE(context.PowMod(base, prime - 1) == 1);
+    EXPECT_TRUE(context.PowMod(base, prime) == Remainder(base, prime));
+  }
+  {
+    BigInteger modulus = (BigInteger(1) << 300) + 2;
+    ModContext context(modulus);
+    BigInteger power(1);
+    BigInteger base = BigInteger::FromString("123456789123456789", 10);
+    for (int i = 0; i < 37; ++i) {
+      power = Remainder(power * base, modulus);
+    }
+    EXPECT_TRUE(context.PowMod(base, BigInteger(37)) == power);
+    EXPECT_THROW(context.PowMod(BigInteger(2), BigInteger(-1)),
+                 std::runtime_error);
+  }
+}
+
+}  // namespace big_num_arithmetic
@@ -0,0 +1,127 @@
+#include "shared_big_integer.h"
+#include <utility>
+
+namespace big_num_arithmetic {
+
+SharedBigInteger::Holder::Holder(BigInteger number)
+    : value(std::move(number)) {}
+
+SharedBigInteger::Holder* SharedBigInteger::Zero() {
+  // Never deleted, so that numbers destroyed at exit can still release it.
+  static Holder* const zero = new Holder(BigInteger());
+  return zero;
+}
+
+SharedBigInteger::Holder* SharedBigInteger::Acquire(Holder* holder) {
+  // A new reference is made from an existing one, so nothing is ordered
+  // by the increment.
+  holder->references.fetch_add(1, std::memory_order_relaxed);
+  return holder;
+}
+
+void SharedBigInteger::Release() {
+  // The release half orders the reads of this copy before the deletion or
+  // the change in place by the last owner; the acquire half lets the last
+  // owner see the reads of all the others.
+  if (holder_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete holder_;
+  }
+}
+
+SharedBigInteger::SharedBigInteger() : holder_(Acquire(Zero())) {}
+
+SharedBigInteger::SharedBigInteger(BigInteger value)
+    : holder_(new Holder(std::move(value))) {}
+
+SharedBigInteger::SharedBigInteger(const SharedBigInteger& other)
+    : holder_(Acquire(other.holder_)) {}
+
+// The moved-from number is zero.
+SharedBigInteger::SharedBigInteger(SharedBigInteger&& other) noexcept
+    : holder_(std::exchange(other.holder_, Acquire(Zero()))) {}
+
+SharedBigInteger& SharedBigInteger::operator=(
+    SharedBigInteger other) noexcept {
+  std::swap(holder_, other.holder_);
+  return *this;
+}
+
+SharedBigInteger::~SharedBigInteger() {
+  Release();
+}
+
+const BigInteger& SharedBigInteger::Get() const {
+  return holder_->value;
+}
+
+const BigInteger& SharedBigInteger::operator*() const {
+  return holder_->value;
+}
+
+const BigInteger* SharedBigInteger::operator->() const {
+  return &holder_->value;
+}
+
+SharedBigInteger::operator const BigInteger&() const {
+  return holder_->value;
+}
+
+BigInteger& SharedBigInteger::Mutable() {
+  // The count can't grow from 1 meanwhile: every other copy would have to
+  // be made from this object. The acquire load orders the change below
+  // after the reads of the copies that are gone.
+  if (holder_->references.load(std::memory_order_acquire) != 1) {
+    Holder* copy = new Holder(holder_->value);
+    Release();
+    holder_ = copy;
+  }
+  holder_->has_hash.store(false, std::memory_order_relaxed);
+  return holder_->value;
+}
+
+bool SharedBigInteger::IsShared() const {
+  return holder_->references.load(std::memory_order_acquire) != 1;
+}
+
+uint64_t SharedBigInteger::Hash() const {
+  // Threads that meet an empty cache compute the same value, so it does
+  // not matter which of them stores it.
+  if (holder_->has_hash.load(std::memory_order_acquire)) {
+    return holder_->hash.load(std::memory_order_relaxed);
+  }
+  uint64_t hash = holder_->value.Hash();
+  holder_->hash.store(hash, std::memory_order_relaxed);
+  holder_->has_hash.store(true, std::memory_order_release);
+  return hash;
+}
+
+// COMPARING
+
+bool SharedBigInteger::operator==(const SharedBigInteger& rhs) const {
+  return holder_ == rhs.holder_ || holder_->value == rhs.holder_->value;
+}
+
+bool SharedBigInteger::operator==(const BigInteger& big_int_rhs) const {
+  return holder_->value == big_int_rhs;
+}
+
+bool SharedBigInteger::operator==(int64_t short_number) const {
+  return holder_->value == short_number;
+}
+
+std::strong_ordering SharedBigInteger::operator<=>(
+    const SharedBigInteger& rhs) const {
+  return holder_->value <=> rhs.holder_->value;
+}
+
+std::strong_ordering SharedBigInteger::operator<=>(
+    const BigInteger& big_int_rhs) const {
+  return holder_->value <=> big_int_rhs;
+}
+
+std::strong_ordering SharedBigInteger::operator<=>(
+    int64_t short_number) const {
+  return holder_->value <=> short_number;
+}
+
+}  // namespace big_num_arithmetic
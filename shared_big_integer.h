@@ -0,0 +1,86 @@
+#ifndef SHARED_BIG_INTEGER_H_
+#define SHARED_BIG_INTEGER_H_
+
+#include "big_integer.h"
+#include <atomic>
+#include <compare>
+#include <functional>
+
+namespace big_num_arithmetic {
+
+// BigInteger behind a reference count, for values that are read much more
+// often than changed: copies share the digits, so copying a number of any
+// size costs one atomic increment. Mutable() makes the digits private
+// first if another copy still uses them (copy-on-write).
+//
+// The count is kept here rather than by std::shared_ptr: its use_count()
+// is a relaxed load, so seeing 1 would not order the writes of Mutable()
+// after the reads of a copy that another thread has just dropped.
+//
+// A shared number converts to const BigInteger&, so it may be passed
+// wherever a BigInteger is read; the operators of BigInteger need Get()
+// on the left side. Copies may be used by different threads, one object
+// may not be changed by one thread while others read it.
+class SharedBigInteger {
+ public:
+  // Zero, which all default-constructed numbers share.
+  SharedBigInteger();
+  SharedBigInteger(BigInteger value);
+  SharedBigInteger(const SharedBigInteger&);
+  SharedBigInteger(SharedBigInteger&&) noexcept;
+  SharedBigInteger& operator=(SharedBigInteger) noexcept;
+  ~SharedBigInteger();
+
+  const BigInteger& Get() const;
+  const BigInteger& operator*() const;
+  const BigInteger* operator->() const;
+  operator const BigInteger&() const;
+
+  // The number to change in place; copies its digits if they are shared.
+  BigInteger& Mutable();
+  // Whether other copies use the same digits.
+  bool IsShared() const;
+  // Get().Hash(), computed once for all the copies.
+  uint64_t Hash() const;
+
+  bool operator==(const SharedBigInteger&) const;
+  bool operator==(const BigInteger&) const;
+  bool operator==(int64_t) const;
+  std::strong_ordering operator<=>(const SharedBigInteger&) const;
+  std::strong_ordering operator<=>(const BigInteger&) const;
+  std::strong_ordering operator<=>(int64_t) const;
+
+ private:
+  struct Holder {
+    explicit Holder(BigInteger);
+
+    BigInteger value;
+    // Copies that use the holder; the last one to go deletes it.
+    mutable std::atomic<uint64_t> references{1};
+    // The hash is valid once has_hash is set; Mutable() resets it.
+    mutable std::atomic<bool> has_hash{false};
+    mutable std::atomic<uint64_t> hash{0};
+  };
+
+  // The holder of zero shared by the default constructor. It keeps one
+  // reference of its own, so it is never deleted.
+  static Holder* Zero();
+  // Takes a new reference to HOLDER.
+  static Holder* Acquire(Holder* holder);
+  // Drops the reference of this object.
+  void Release();
+
+  Holder* holder_;
+};
+
+}  // namespace big_num_arithmetic
+
+// Equal to std::hash<BigInteger> of the same number.
+template<>
+struct std::hash<big_num_arithmetic::SharedBigInteger> {
+  size_t operator()(const big_num_arithmetic::SharedBigInteger& value) const {
+    return static_cast<size_t>(value.Hash());
+  }
+};
+
+#endif  // SHARED_BIG_INTEGER_H_
@@ -0,0 +1,99 @@
+#include "shared_big_integer.h"
+#include "equation_solver.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace big_num_arithmetic {
+
+TEST(Test_40, SharedBigInteger) {
+  {
+    SharedBigInteger zero;
+    EXPECT_TRUE(zero == 0 && zero.Get().Sign() == 0);
+    EXPECT_TRUE(SharedBigInteger() == zero);
+  }
+  {
+    BigInteger big = (BigInteger(1) << 10000) + 3;
+    SharedBigInteger original(big);
+    SharedBigInteger copy = original;
+    EXPECT_TRUE(original.IsShared() && copy.IsShared());
+    EXPECT_EQ(&original.Get(), &copy.Get());
+    EXPECT_TRUE(copy == big && copy == original && copy > 3 &&
+                copy < big + 1 && -5 < copy);
+    EXPECT_TRUE(copy.Get() - 3 == BigInteger(1) << 10000);
+    EXPECT_EQ(copy->BitLength(), 10001u);
+
+    // The first change separates the copy.
+    copy.Mutable() += 1;
+    EXPECT_FALSE(original.IsShared() || copy.IsShared());
+    EXPECT_TRUE(original == big && copy == big + 1 && original < copy);
+    const BigInteger* digits = &copy.Get();
+    copy.Mutable() -= 1;
+    EXPECT_EQ(&copy.Get(), digits);
+    EXPECT_TRUE(copy == original);
+  }
+  {
+    SharedBigInteger value(BigInteger::Factorial(100));
+    SharedBigInteger copy = value;
+    EXPECT_EQ(std::hash<SharedBigInteger>()(value),
+              std::hash<BigInteger>()(BigInteger::Factorial(100)));
+    EXPECT_EQ(copy.Hash(), value.Hash());
+    copy.Mutable() += 1;
+    EXPECT_EQ(copy.Hash(), (BigInteger::Factorial(100) + 1).Hash());
+    EXPECT_EQ(value.Hash(), BigInteger::Factorial(100).Hash());
+
+    std::unordered_map<SharedBigInteger, int> counts;
+    for (int i = 0; i < 10; ++i) {
+      counts[value]++;
+      counts[SharedBigInteger(BigInteger::Factorial(100) + i)]++;
+    }
+    EXPECT_EQ(counts.size(), 10u);
+    EXPECT_EQ(counts[value], 11);
+  }
+  {
+    // Equations from one coefficient share its digits.
+    SharedBigInteger a(BigInteger::Factorial(500));
+    equation_solver::QuadraticEquation first =
+        equation_solver::GenerateEquation(a, BigInteger(2), BigInteger(-3));
+    equation_solver::QuadraticEquation second =
+        equation_solver::GenerateEquation(a, BigInteger(5), BigInteger(7));
+    EXPECT_EQ(&first.a.Get(), &second.a.Get());
+    equation_solver::QuadraticEquation copy = second;
+    EXPECT_EQ(&copy.c.Get(), &second.c.Get());
+    BigInteger root_1;
+    BigInteger root_2;
+    EXPECT_TRUE(equation_solver::Solve(copy, root_1, root_2));
+    EXPECT_TRUE(root_1 == 5 && root_2 == 7);
+  }
+  {
+    // Copies read and dropped by other threads while the original changes
+    // in place once it is the last one.
+    BigInteger big = BigInteger::Factorial(300);
+    for (int round = 0; round < 50; ++round) {
+      SharedBigInteger original(big);
+      std::atomic<int> matches{0};
+      std::vector<std::thread> readers;
+      for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([copy = original, &big, &matches]() mutable {
+          if (copy == big) {
+            matches++;
+          }
+          copy = SharedBigInteger();
+        });
+      }
+      for (int i = 0; i < 100; ++i) {
+        original.Mutable() += 1;
+      }
+      for (std::thread& reader : readers) {
+        reader.join();
+      }
+      EXPECT_EQ(matches.load(), 4);
+      EXPECT_TRUE(original == big + 100);
+      EXPECT_FALSE(original.IsShared());
+    }
+  }
+}
+
+}  // namespace big_num_arithmetic